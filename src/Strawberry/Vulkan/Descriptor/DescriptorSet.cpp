@@ -5,7 +5,7 @@
 #include "Strawberry/Vulkan/Descriptor/DescriptorSet.hpp"
 #include "Strawberry/Vulkan/Descriptor/Sampler.hpp"
 #include "Strawberry/Vulkan/Device/Device.hpp"
-#include "Strawberry/Vulkan/Resource/Buffer.hpp"
+#include "Strawberry/Vulkan/Resource/BufferSlice.hpp"
 #include "Strawberry/Vulkan/Resource/ImageView.hpp"
 // Standard Library
 #include <memory>
@@ -80,47 +80,25 @@ namespace Strawberry::Vulkan
 
 	void DescriptorSet::SetUniformBuffer(uint32_t binding, uint32_t arrayElement, const Buffer& buffer)
 	{
-		VkDescriptorBufferInfo bufferInfo{
-			.buffer = buffer,
-			.offset = 0,
-			.range = buffer.GetSize()
-		};
-		VkWriteDescriptorSet write{
-			.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-			.pNext = nullptr,
-			.dstSet = mDescriptorSet,
-			.dstBinding = binding,
-			.dstArrayElement = arrayElement,
-			.descriptorCount = 1,
-			.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-			.pImageInfo = nullptr,
-			.pBufferInfo = &bufferInfo,
-			.pTexelBufferView = nullptr,
-		};
-		vkUpdateDescriptorSets(mDescriptorPool->GetDevice()->Handle(), 1, &write, 0, nullptr);
+		SetBuffer(binding, arrayElement, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, buffer);
+	}
+
+
+	void DescriptorSet::SetUniformBuffer(uint32_t binding, uint32_t arrayElement, const BufferSlice& slice)
+	{
+		SetBuffer(binding, arrayElement, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, slice);
 	}
 
 
 	void DescriptorSet::SetStorageBuffer(uint32_t binding, uint32_t arrayElement, const Strawberry::Vulkan::Buffer& buffer)
 	{
-		VkDescriptorBufferInfo bufferInfo{
-			.buffer = buffer,
-			.offset = 0,
-			.range = buffer.GetSize()
-		};
-		VkWriteDescriptorSet write{
-			.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-			.pNext = nullptr,
-			.dstSet = mDescriptorSet,
-			.dstBinding = binding,
-			.dstArrayElement = arrayElement,
-			.descriptorCount = 1,
-			.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
-			.pImageInfo = nullptr,
-			.pBufferInfo = &bufferInfo,
-			.pTexelBufferView = nullptr,
-		};
-		vkUpdateDescriptorSets(mDescriptorPool->GetDevice()->Handle(), 1, &write, 0, nullptr);
+		SetBuffer(binding, arrayElement, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, buffer);
+	}
+
+
+	void DescriptorSet::SetStorageBuffer(uint32_t binding, uint32_t arrayElement, const BufferSlice& slice)
+	{
+		SetBuffer(binding, arrayElement, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, slice);
 	}
 
 
@@ -200,4 +178,27 @@ namespace Strawberry::Vulkan
 		: mDescriptorSet(set)
 		, mDescriptorPool(pool)
 	{}
+
+
+	void DescriptorSet::SetBuffer(uint32_t binding, uint32_t arrayElement, VkDescriptorType type, const BufferSlice& slice)
+	{
+		VkDescriptorBufferInfo bufferInfo{
+			.buffer = slice.buffer,
+			.offset = slice.offset,
+			.range = slice.size
+		};
+		VkWriteDescriptorSet write{
+			.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+			.pNext = nullptr,
+			.dstSet = mDescriptorSet,
+			.dstBinding = binding,
+			.dstArrayElement = arrayElement,
+			.descriptorCount = 1,
+			.descriptorType = type,
+			.pImageInfo = nullptr,
+			.pBufferInfo = &bufferInfo,
+			.pTexelBufferView = nullptr,
+		};
+		vkUpdateDescriptorSets(mDescriptorPool->GetDevice()->Handle(), 1, &write, 0, nullptr);
+	}
 }
@@ -22,6 +22,7 @@ namespace Strawberry::Vulkan
 	class Sampler;
 	class ImageView;
 	class Buffer;
+	struct BufferSlice;
 
 
 	class DescriptorSet
@@ -43,7 +44,9 @@ namespace Strawberry::Vulkan
 
 
 		void SetUniformBuffer(uint32_t binding, uint32_t arrayElement, const Buffer& buffer);
+		void SetUniformBuffer(uint32_t binding, uint32_t arrayElement, const BufferSlice& slice);
 		void SetStorageBuffer(uint32_t binding, uint32_t arrayElement, const Buffer& buffer);
+		void SetStorageBuffer(uint32_t binding, uint32_t arrayElement, const BufferSlice& slice);
 
 
 		void SetTexture(uint32_t binding, uint32_t arrayElement, const ImageView& imageView, VkImageLayout layout);
@@ -54,6 +57,9 @@ namespace Strawberry::Vulkan
 		DescriptorSet(VkDescriptorSet set, DescriptorPool& pool);
 
 
+		void SetBuffer(uint32_t binding, uint32_t arrayElement, VkDescriptorType type, const BufferSlice& slice);
+
+
 		VkDescriptorSet                        mDescriptorSet;
 		Core::ReflexivePointer<DescriptorPool> mDescriptorPool;
 	};
@@ -5,14 +5,20 @@
 #include "Device.hpp"
 #include "Strawberry/Vulkan/Device/Instance.hpp"
 #include "Strawberry/Vulkan/Device/DescriptorPoolAllocator.hpp"
+#include "Strawberry/Vulkan/Memory/DeferredReleaseQueue.hpp"
+#include "Strawberry/Vulkan/Memory/HostMemoryImporter.hpp"
+#include "Strawberry/Vulkan/Memory/ResidencyManager.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/ConcurrentPolyAllocator.hpp"
 #include "Strawberry/Vulkan/Memory/Allocator/FallbackAllocator.hpp"
-#include "Strawberry/Vulkan/Memory/Allocator/FreelistAllocator.hpp"
-#include "Strawberry/Vulkan/Memory/Allocator/NaivePolyAllocator.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/RecordingPolyAllocator.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/TLSFAllocator.hpp"
+#include "Strawberry/Vulkan/Queue/UploadManager.hpp"
 // Strawberry Core
 #include "Strawberry/Core/Assert.hpp"
 // Standard Library
 #include <algorithm>
 #include <deque>
+#include <fstream>
 #include <utility>
 #include <vector>
 
@@ -40,7 +46,8 @@ namespace Strawberry::Vulkan
 	Device::Device(
 		const PhysicalDevice&        physicalDevice,
 		const VkPhysicalDeviceFeatures& features,
-		std::vector<QueueCreateInfo> queueCreateInfo)
+		std::vector<QueueCreateInfo> queueCreateInfo,
+		const Core::Optional<std::filesystem::path>& allocationTracePath)
 			: mDevice{}
 			, mPhysicalDevice(physicalDevice)
 	{
@@ -92,11 +99,39 @@ namespace Strawberry::Vulkan
 		}
 
 
+		// Enable memory budget queries if available
+		if (GetPhysicalDevice().SupportsExtension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME))
+		{
+			extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+		}
+
+
+		// Enable importing host memory if available, see HostMemoryImporter.
+		if (GetPhysicalDevice().SupportsExtension(VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME))
+		{
+			extensions.push_back(VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME);
+		}
+
+
+		// Enable memory priorities if available, which tell the driver what to keep resident under memory pressure.
+		VkPhysicalDeviceMemoryPriorityFeaturesEXT memoryPriorityFeatures
+		{
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PRIORITY_FEATURES_EXT,
+			.pNext = nullptr,
+			.memoryPriority = VK_TRUE,
+		};
+		mMemoryPriority = GetPhysicalDevice().SupportsMemoryPriority();
+		if (mMemoryPriority)
+		{
+			extensions.push_back(VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME);
+		}
+
+
 		// Populate info struct
 		VkDeviceCreateInfo createInfo
 		{
 			.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-			.pNext = nullptr,
+			.pNext = mMemoryPriority ? &memoryPriorityFeatures : nullptr,
 			.flags = 0,
 			.queueCreateInfoCount = static_cast<uint32_t>(queues.size()),
 			.pQueueCreateInfos = queues.data(),
@@ -122,8 +157,16 @@ namespace Strawberry::Vulkan
 					queueFamilyProperties[createInfo.familyIndex].queueFlags));
 		}
 
-		mAllocator = std::make_unique<NaivePolyAllocator<FallbackChainAllocator<FreeListAllocator>>>(*this);
+		mAllocator = std::make_unique<ConcurrentPolyAllocator<FallbackChainAllocator<TLSFAllocator>>>(*this);
+		if (allocationTracePath)
+		{
+			auto trace = std::make_unique<std::ofstream>(allocationTracePath.Value(), std::ios::binary);
+			Core::Assert(trace->is_open());
+			mAllocator = std::make_unique<RecordingPolyAllocator>(std::move(mAllocator), std::move(trace));
+		}
 		mDescriptorPoolAllocator = std::make_unique<DescriptorPoolAllocator>(*this);
+		mDeferredReleases = std::make_unique<DeferredReleaseQueue>(*this);
+		mHostMemoryImporter = std::make_unique<HostMemoryImporter>(*this);
 	}
 
 
@@ -132,7 +175,13 @@ namespace Strawberry::Vulkan
 		  , mPhysicalDevice(std::move(rhs.mPhysicalDevice))
 		  , mQueues(std::move(rhs.mQueues))
 		  , mAllocator(std::move(rhs.mAllocator))
-		  , mDescriptorPoolAllocator(std::move(rhs.mDescriptorPoolAllocator)) {}
+		  , mDescriptorPoolAllocator(std::move(rhs.mDescriptorPoolAllocator))
+		  , mDeferredReleases(std::move(rhs.mDeferredReleases))
+		  , mHostMemoryImporter(std::move(rhs.mHostMemoryImporter))
+		  , mUploadManager(std::move(rhs.mUploadManager))
+		  , mResidencyManager(std::move(rhs.mResidencyManager))
+		  , mSubmissionCount(rhs.mSubmissionCount.load())
+		  , mMemoryPriority(rhs.mMemoryPriority) {}
 
 
 	Device& Device::operator=(Device&& rhs) noexcept
@@ -153,7 +202,13 @@ namespace Strawberry::Vulkan
 
 		if (mDevice)
 		{
+			// Unflushed uploads are submitted and waited on, and release their staging buffers, so this goes first.
+			mUploadManager.reset();
+			mResidencyManager.reset();
 			WaitUntilIdle();
+			// Released resources hold memory from the allocator, so must go first.
+			mDeferredReleases.reset();
+			mHostMemoryImporter.reset();
 			mAllocator.reset();
 			mQueues.clear();
 			mAllocator.reset();
@@ -181,6 +236,7 @@ namespace Strawberry::Vulkan
 		ZoneScoped;
 
 		Core::AssertEQ(vkDeviceWaitIdle(mDevice), VK_SUCCESS);
+		mDeferredReleases->Collect();
 	}
 
 
@@ -224,6 +280,95 @@ namespace Strawberry::Vulkan
 	}
 
 
+	DeferredReleaseQueue& Device::GetDeferredReleases() const
+	{
+		return *mDeferredReleases;
+	}
+
+
+	HostMemoryImporter& Device::GetHostMemoryImporter() const
+	{
+		return *mHostMemoryImporter;
+	}
+
+
+	UploadManager& Device::GetUploadManager() const
+	{
+		std::lock_guard lock(mUploadManagerMutex);
+		if (!mUploadManager)
+		{
+			mUploadManager = std::make_unique<UploadManager>(GetTransferCapableQueue());
+		}
+
+		return *mUploadManager;
+	}
+
+
+	ResidencyManager& Device::GetResidencyManager() const
+	{
+		std::lock_guard lock(mResidencyManagerMutex);
+		if (!mResidencyManager)
+		{
+			mResidencyManager = std::make_unique<ResidencyManager>(GetTransferCapableQueue());
+		}
+
+		return *mResidencyManager;
+	}
+
+
+	uint64_t Device::LastSubmission() const noexcept
+	{
+		return mSubmissionCount.load();
+	}
+
+
+	uint64_t Device::CompletedSubmission() const
+	{
+		// Read the last submission first. Anything numbered up to it is already pending on its queue by now, since
+		// queues number their submissions while holding their own lock.
+		uint64_t completed = LastSubmission();
+		for (const auto& [family, queues] : mQueues)
+		{
+			for (const Queue& queue : queues)
+			{
+				if (auto oldest = queue.OldestPendingSubmission())
+				{
+					completed = std::min(completed, oldest.Value() - 1);
+				}
+			}
+		}
+		return completed;
+	}
+
+
+	Queue& Device::GetTransferCapableQueue() const
+	{
+		// Graphics and compute queues can always transfer, even when they do not say so.
+		const auto capability = [](VkQueueFlags flags)
+		{
+			if (flags & VK_QUEUE_GRAPHICS_BIT) return 3;
+			if (flags & VK_QUEUE_COMPUTE_BIT) return 2;
+			if (flags & VK_QUEUE_TRANSFER_BIT) return 1;
+			return 0;
+		};
+		const auto family = std::ranges::max_element(mQueues, {}, [&](const auto& family)
+		{
+			return capability(family.second.front().GetFlags());
+		});
+		Core::Assert(family != mQueues.end() && capability(family->second.front().GetFlags()) > 0);
+
+		// Queues are only submitted to through non-const references, but the managers using this are shared by the
+		// device.
+		return const_cast<Queue&>(family->second.front());
+	}
+
+
+	uint64_t Device::NextSubmission() noexcept
+	{
+		return mSubmissionCount.fetch_add(1) + 1;
+	}
+
+
 	Result<DescriptorSet> Device::AllocateDescriptorSet(const DescriptorSetLayout& descriptorSetLayout)
 	{
 		return mDescriptorPoolAllocator->Allocate(*this, descriptorSetLayout);
@@ -301,6 +446,6 @@ namespace Strawberry::Vulkan
 
 	Device Device::Builder::Build()
 	{
-		return Device(device, *mFeatures, mQueueCreateInfo);
+		return Device(device, *mFeatures, mQueueCreateInfo, mAllocationTracePath);
 	}
 }
@@ -13,6 +13,10 @@
 // Vulkan
 #include <vulkan/vulkan.h>
 // Standard Library
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <map>
 
@@ -30,6 +34,10 @@ namespace Strawberry::Vulkan
 	class DescriptorPoolAllocator;
 	class PolyAllocator;
 	class DescriptorSetLayout;
+	class DeferredReleaseQueue;
+	class HostMemoryImporter;
+	class ResidencyManager;
+	class UploadManager;
 
 
 	struct QueueCreateInfo
@@ -56,6 +64,8 @@ namespace Strawberry::Vulkan
 	class Device
 			: public Core::EnableReflexivePointer
 	{
+		friend class Queue;
+
 	public:
 		class Builder;
 
@@ -87,12 +97,46 @@ namespace Strawberry::Vulkan
 
 		[[nodiscard]] PolyAllocator& GetAllocator() const;
 
+		// Returns the queue which destroyed resources wait in until the GPU is done with them.
+		[[nodiscard]] DeferredReleaseQueue& GetDeferredReleases() const;
+
+		// Returns the allocator which imports host memory for the device to use in place.
+		[[nodiscard]] HostMemoryImporter& GetHostMemoryImporter() const;
+
+		// Returns the upload manager used for filling resources which the host cannot write to. It is created on first
+		// use, on a graphics queue if there is one, so that resources do not need to change queue family.
+		[[nodiscard]] UploadManager& GetUploadManager() const;
+
+		// Returns the residency manager which moves registered resources out of device local memory under memory
+		// pressure. It is created on first use, on the same queue as the upload manager, and registered resources must
+		// only be used on that queue, see ResidencyManager::GetQueue().
+		[[nodiscard]] ResidencyManager& GetResidencyManager() const;
+
+
+		// Every submission to any of this device's queues is numbered in order, starting from one. These form a
+		// timeline which resource lifetimes are tracked against, see DeferredReleaseQueue.
+		//
+		// Returns the number of the most recent submission.
+		[[nodiscard]] uint64_t LastSubmission() const noexcept;
+		// Returns the number up to which every submission has completed.
+		[[nodiscard]] uint64_t CompletedSubmission() const;
+
+		// Whether allocations can be given priorities with VK_EXT_memory_priority, see AllocationRequest::WithPriority().
+		[[nodiscard]] bool HasMemoryPriority() const noexcept { return mMemoryPriority; }
+
 		[[nodiscard]] Result<DescriptorSet> AllocateDescriptorSet(const DescriptorSetLayout& descriptorSetLayout);
 
 	private:
-		explicit Device(const PhysicalDevice&           physicalDevice,
-						const VkPhysicalDeviceFeatures& features,
-						std::vector<QueueCreateInfo>    queueCreateInfo);
+		explicit Device(const PhysicalDevice&                        physicalDevice,
+						const VkPhysicalDeviceFeatures&              features,
+						std::vector<QueueCreateInfo>                 queueCreateInfo,
+						const Core::Optional<std::filesystem::path>& allocationTracePath);
+
+
+		// Allocates the number of a new submission.
+		uint64_t NextSubmission() noexcept;
+		// Returns the first queue of the family best able to transfer, preferring families which can do more.
+		Queue& GetTransferCapableQueue() const;
 
 
 		VkDevice                                     mDevice;
@@ -100,6 +144,14 @@ namespace Strawberry::Vulkan
 		std::map<uint32_t, std::vector<Queue>>       mQueues;
 		std::unique_ptr<PolyAllocator>               mAllocator;
 		std::unique_ptr<DescriptorPoolAllocator>     mDescriptorPoolAllocator;
+		std::unique_ptr<DeferredReleaseQueue>        mDeferredReleases;
+		std::unique_ptr<HostMemoryImporter>          mHostMemoryImporter;
+		mutable std::mutex                           mUploadManagerMutex;
+		mutable std::unique_ptr<UploadManager>       mUploadManager;
+		mutable std::mutex                           mResidencyManagerMutex;
+		mutable std::unique_ptr<ResidencyManager>    mResidencyManager;
+		std::atomic<uint64_t>                        mSubmissionCount = 0;
+		bool                                         mMemoryPriority = false;
 	};
 
 
@@ -117,11 +169,16 @@ namespace Strawberry::Vulkan
 
 		Builder& WithQueue(const QueueCriteria& queueCriteria, unsigned int count = 1);
 
+		// Records every allocation and free made through the device's allocator to the given file, see
+		// RecordingPolyAllocator.
+		Builder& WithAllocationTrace(std::filesystem::path path) { mAllocationTracePath = std::move(path); return *this; }
+
 		Device Build();
 
 	private:
 		const PhysicalDevice& device;
 		std::unique_ptr<VkPhysicalDeviceFeatures> mFeatures;
 		std::vector<QueueCreateInfo> mQueueCreateInfo;
+		Core::Optional<std::filesystem::path> mAllocationTracePath;
 	};
 }
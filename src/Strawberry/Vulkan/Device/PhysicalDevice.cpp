@@ -5,7 +5,7 @@
 #include "Strawberry/Vulkan/Device/Instance.hpp"
 // Standard Library
 #include <algorithm>
-#include <numeric>
+#include <bit>
 #include <ranges>
 
 #include "Device.hpp"
@@ -167,17 +167,13 @@ namespace Strawberry::Vulkan
 		VkMemoryPropertyFlags requiredProperties                   = memoryCriteria.requiredProperties;
 		VkMemoryPropertyFlags preferredProperties                  = memoryCriteria.preferredProperties;
 		const auto&           [typeCount, types, heapCount, heaps] = GetMemoryProperties();
-		std::vector<uint32_t> memoryTypes(typeCount);
-		std::iota(memoryTypes.begin(), memoryTypes.end(), 0);
 
 		std::vector<uint32_t> viableMemoryTypes;
-		// Guess that half of the memory types are available.
-		// This is probably a sensible assumption.
-		viableMemoryTypes.reserve(typeCount / 2);
-		for (uint32_t type: memoryTypes)
+		viableMemoryTypes.reserve(typeCount);
+		for (uint32_t type = 0; type < typeCount; type++)
 		{
 			const bool hasRequiredProperties = requiredProperties == (types[type].propertyFlags & requiredProperties);
-			const bool isLargeEnough = mMemoryProperties->memoryHeaps[types[type].heapIndex].size >= memoryCriteria.minimumSize;
+			const bool isLargeEnough = heaps[types[type].heapIndex].size >= memoryCriteria.minimumSize;
 			if (hasRequiredProperties && isLargeEnough)
 			{
 				viableMemoryTypes.emplace_back(type);
@@ -185,33 +181,132 @@ namespace Strawberry::Vulkan
 		}
 
 
-		std::vector<uint32_t> preferredMemoryTypes;
-		preferredMemoryTypes.reserve(typeCount);
-		for (uint32_t type: viableMemoryTypes)
+		// Rank types by how many of the preferred properties they have, and then by how few properties they have which
+		// were not asked for. The latter keeps device only resources out of small host visible heaps on ReBAR
+		// systems, and host resources out of device memory on discrete GPUs.
+		auto preferredCount = [&](uint32_t type)
 		{
-			if (preferredProperties == (types[type].propertyFlags & preferredProperties))
-			{
-				preferredMemoryTypes.emplace_back(type);
-			}
-		}
-
-
-		std::vector<uint32_t> candidates = !preferredMemoryTypes.empty()
-		                                   ? preferredMemoryTypes
-		                                   : !viableMemoryTypes.empty()
-		                                     ? viableMemoryTypes
-		                                     : std::vector<uint32_t>();
+			return std::popcount(types[type].propertyFlags & preferredProperties);
+		};
+		auto unrequestedCount = [&](uint32_t type)
+		{
+			return std::popcount(types[type].propertyFlags & ~(requiredProperties | preferredProperties));
+		};
+		std::ranges::stable_sort(viableMemoryTypes, [&](uint32_t a, uint32_t b)
+		{
+			if (preferredCount(a) != preferredCount(b)) return preferredCount(a) > preferredCount(b);
+			return unrequestedCount(a) < unrequestedCount(b);
+		});
 
 
-		return candidates
+		return viableMemoryTypes
 				| std::ranges::views::transform([&](uint32_t type)
 				{
 					return MemoryType{
 						.index = MemoryTypeIndex{ .physicalDevice = mPhysicalDevice, .memoryTypeIndex = type },
+						.heapIndex = types[type].heapIndex,
 						.heapSize = heaps[types[type].heapIndex].size,
 						.properties = types[type].propertyFlags,
 					};
 				})
 				| std::ranges::to<std::vector>();
 	}
+
+
+	bool PhysicalDevice::SupportsExtension(std::string_view extensionName) const
+	{
+		return std::ranges::any_of(GetExtensionProperties(), [&](const VkExtensionProperties& extension)
+		{
+			return extensionName == extension.extensionName;
+		});
+	}
+
+
+	Core::Optional<VkDeviceSize> PhysicalDevice::GetMinImportedHostPointerAlignment() const
+	{
+		if (!mMinImportedHostPointerAlignment)
+		{
+			mMinImportedHostPointerAlignment.Emplace();
+			if (SupportsExtension(VK_EXT_EXTERNAL_MEMORY_HOST_EXTENSION_NAME))
+			{
+				VkPhysicalDeviceExternalMemoryHostPropertiesEXT hostProperties
+				{
+					.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTERNAL_MEMORY_HOST_PROPERTIES_EXT,
+					.pNext = nullptr,
+				};
+				VkPhysicalDeviceProperties2 properties
+				{
+					.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+					.pNext = &hostProperties,
+				};
+				vkGetPhysicalDeviceProperties2(mPhysicalDevice, &properties);
+				mMinImportedHostPointerAlignment->Emplace(hostProperties.minImportedHostPointerAlignment);
+			}
+		}
+
+		return mMinImportedHostPointerAlignment.Value();
+	}
+
+
+	bool PhysicalDevice::SupportsMemoryPriority() const
+	{
+		if (!mMemoryPrioritySupport)
+		{
+			mMemoryPrioritySupport.Emplace(false);
+			if (SupportsExtension(VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME))
+			{
+				VkPhysicalDeviceMemoryPriorityFeaturesEXT priorityFeatures
+				{
+					.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PRIORITY_FEATURES_EXT,
+					.pNext = nullptr,
+				};
+				VkPhysicalDeviceFeatures2 features
+				{
+					.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2,
+					.pNext = &priorityFeatures,
+				};
+				vkGetPhysicalDeviceFeatures2(mPhysicalDevice, &features);
+				mMemoryPrioritySupport.Emplace(priorityFeatures.memoryPriority == VK_TRUE);
+			}
+		}
+
+		return mMemoryPrioritySupport.Value();
+	}
+
+
+	std::array<MemoryHeapBudget, VK_MAX_MEMORY_HEAPS> PhysicalDevice::GetMemoryBudget() const
+	{
+		const auto& memoryProperties = GetMemoryProperties();
+
+		std::array<MemoryHeapBudget, VK_MAX_MEMORY_HEAPS> heapBudgets{};
+		if (SupportsExtension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME))
+		{
+			VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties
+			{
+				.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT,
+				.pNext = nullptr,
+			};
+			VkPhysicalDeviceMemoryProperties2 properties
+			{
+				.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2,
+				.pNext = &budgetProperties,
+			};
+			vkGetPhysicalDeviceMemoryProperties2(mPhysicalDevice, &properties);
+
+			for (uint32_t heap = 0; heap < memoryProperties.memoryHeapCount; heap++)
+			{
+				heapBudgets[heap] = {.budget = budgetProperties.heapBudget[heap], .usage = budgetProperties.heapUsage[heap]};
+			}
+		}
+		else
+		{
+			// Without the extension the best we know is the size of each heap.
+			for (uint32_t heap = 0; heap < memoryProperties.memoryHeapCount; heap++)
+			{
+				heapBudgets[heap] = {.budget = memoryProperties.memoryHeaps[heap].size, .usage = 0};
+			}
+		}
+
+		return heapBudgets;
+	}
 }
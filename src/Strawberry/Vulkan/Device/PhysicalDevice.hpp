@@ -10,6 +10,8 @@
 // Vulkan
 #include <vulkan/vulkan.h>
 // Standard Library
+#include <array>
+#include <string_view>
 #include <vector>
 
 
@@ -47,12 +49,27 @@ namespace Strawberry::Vulkan
 		const std::vector<VkQueueFamilyProperties>& GetQueueFamilyProperties() const;
 		const VkPhysicalDeviceMemoryProperties&     GetMemoryProperties() const;
 		const std::vector<VkExtensionProperties>&   GetExtensionProperties() const;
+		// Returns the alignment which the address and size of host memory must have to be imported, or nothing if
+		// VK_EXT_external_memory_host is not supported.
+		Core::Optional<VkDeviceSize>                GetMinImportedHostPointerAlignment() const;
+		// Returns whether VK_EXT_memory_priority is supported, along with its memoryPriority feature.
+		bool                                        SupportsMemoryPriority() const;
 
 
 		std::vector<uint32_t>   SearchQueueFamilies(VkQueueFlags flagBits) const;
 		std::vector<uint32_t>   SearchQueueFamilies(const QueueCriteria& queueCriteria) const;
+		// Returns the memory types meeting the given criteria, best suited first.
 		std::vector<MemoryType> SearchMemoryTypes(const MemoryTypeCriteria& memoryCriteria) const;
 
+
+		bool SupportsExtension(std::string_view extensionName) const;
+
+
+		// Returns the current budget and usage of each memory heap, indexed by heap index.
+		// These come from VK_EXT_memory_budget when it is supported, otherwise the budget is the size of the heap and
+		// usage is unknown. Unlike the other properties this is queried afresh on each call.
+		std::array<MemoryHeapBudget, VK_MAX_MEMORY_HEAPS> GetMemoryBudget() const;
+
 	protected:
 		PhysicalDevice(Instance& instance, VkPhysicalDevice rawHandle);
 
@@ -68,5 +85,7 @@ namespace Strawberry::Vulkan
 		mutable Core::Optional<std::vector<VkQueueFamilyProperties>> mQueueFamilyProperties;
 		mutable Core::Optional<VkPhysicalDeviceMemoryProperties>     mMemoryProperties;
 		mutable Core::Optional<std::vector<VkExtensionProperties>>   mExtensionProperties;
+		mutable Core::Optional<Core::Optional<VkDeviceSize>>         mMinImportedHostPointerAlignment;
+		mutable Core::Optional<bool>                                 mMemoryPrioritySupport;
 	};
 }
@@ -88,7 +88,7 @@ namespace Strawberry::Vulkan
 		Core::AssertEQ(vkGetSwapchainImagesKHR(queue.GetDevice().Handle(), mSwapchain, &imageCount, imageHandles.data()), VK_SUCCESS);
 		for (VkImage handle: imageHandles)
 		{
-			Image image(handle, mSize.AsType<unsigned int>().AppendedWith(1), mFormat.format);
+			Image image(queue.GetDevice(), handle, mSize.AsType<unsigned int>().AppendedWith(1), mFormat.format);
 			mImages.emplace_back(std::move(image));
 		}
 	}
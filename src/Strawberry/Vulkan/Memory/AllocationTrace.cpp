@@ -0,0 +1,76 @@
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+#include "AllocationTrace.hpp"
+// Standard Library
+#include <algorithm>
+#include <array>
+
+
+//======================================================================================================================
+//  Method Definitions
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	static constexpr std::array<char, 4> ALLOCATION_TRACE_MAGIC   = {'S', 'V', 'A', 'T'};
+	static constexpr uint32_t            ALLOCATION_TRACE_VERSION = 1;
+
+
+	void WriteAllocationTraceHeader(std::ostream& stream)
+	{
+		stream.write(ALLOCATION_TRACE_MAGIC.data(), ALLOCATION_TRACE_MAGIC.size());
+		stream.write(reinterpret_cast<const char*>(&ALLOCATION_TRACE_VERSION), sizeof(ALLOCATION_TRACE_VERSION));
+	}
+
+
+	void WriteAllocationTraceRecord(std::ostream& stream, const AllocationTraceRecord& record)
+	{
+		const size_t size = record.event == AllocationTraceEvent::Allocate
+			? ALLOCATION_TRACE_ALLOCATE_SIZE
+			: ALLOCATION_TRACE_FREE_SIZE;
+		stream.put(static_cast<char>(record.event));
+		stream.write(reinterpret_cast<const char*>(&record), static_cast<std::streamsize>(size));
+	}
+
+
+	Core::Optional<std::vector<AllocationTraceRecord>> ReadAllocationTrace(std::istream& stream)
+	{
+		std::array<char, 4> magic{};
+		uint32_t            version = 0;
+		stream.read(magic.data(), magic.size());
+		stream.read(reinterpret_cast<char*>(&version), sizeof(version));
+		if (!stream || magic != ALLOCATION_TRACE_MAGIC || version != ALLOCATION_TRACE_VERSION)
+		{
+			return Core::NullOpt;
+		}
+
+		std::vector<AllocationTraceRecord> records;
+		char event;
+		while (stream.get(event))
+		{
+			AllocationTraceRecord record{};
+			record.event = static_cast<AllocationTraceEvent>(event);
+
+			size_t size;
+			switch (record.event)
+			{
+				case AllocationTraceEvent::Allocate:
+					size = ALLOCATION_TRACE_ALLOCATE_SIZE;
+					break;
+				case AllocationTraceEvent::Free:
+					size = ALLOCATION_TRACE_FREE_SIZE;
+					break;
+				default:
+					return Core::NullOpt;
+			}
+
+			if (!stream.read(reinterpret_cast<char*>(&record), static_cast<std::streamsize>(size)))
+			{
+				break;
+			}
+			records.emplace_back(record);
+		}
+
+		return records;
+	}
+}
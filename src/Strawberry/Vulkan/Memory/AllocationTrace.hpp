@@ -0,0 +1,71 @@
+#pragma once
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+// Strawberry Core
+#include "Strawberry/Core/Types/Optional.hpp"
+// Standard Library
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+
+//======================================================================================================================
+//  Class Declaration
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	// Allocation traces are a header followed by one entry per event. Each entry is a single AllocationTraceEvent byte
+	// followed by the leading bytes of an AllocationTraceRecord: all of it for allocations, but only the timestamp and
+	// id for frees. Values are stored in the byte order of the machine which recorded them.
+	enum class AllocationTraceEvent : uint8_t
+	{
+		Allocate,
+		Free,
+	};
+
+
+	struct AllocationTraceRecord
+	{
+		// Nanoseconds since recording started.
+		uint64_t             timestamp;
+		// Identifies the block in the event which frees it. Zero for allocations which failed.
+		uint64_t             id;
+
+		// The request, and the criteria that memory types were chosen by.
+		uint64_t             size                = 0;
+		uint64_t             alignment           = 0;
+		uint64_t             minimumSize         = 0;
+		// The offset of the block within its device memory.
+		uint64_t             offset              = 0;
+		uint32_t             typeMask            = 0;
+		uint32_t             requiredProperties  = 0;
+		uint32_t             preferredProperties = 0;
+		uint8_t              resourceKind        = 0;
+		uint8_t              dedicated           = 0;
+		uint8_t              succeeded           = 0;
+		// The memory type the block was allocated from.
+		uint8_t              memoryTypeIndex     = 0;
+
+		AllocationTraceEvent event               = AllocationTraceEvent::Allocate;
+	};
+
+
+	// The number of bytes of an AllocationTraceRecord stored for each kind of event.
+	static constexpr size_t ALLOCATION_TRACE_ALLOCATE_SIZE = offsetof(AllocationTraceRecord, event);
+	static constexpr size_t ALLOCATION_TRACE_FREE_SIZE     = offsetof(AllocationTraceRecord, size);
+	static_assert(ALLOCATION_TRACE_ALLOCATE_SIZE == 64);
+
+
+	// Writes the header which every trace starts with.
+	void WriteAllocationTraceHeader(std::ostream& stream);
+
+	// Appends a single event to a trace.
+	void WriteAllocationTraceRecord(std::ostream& stream, const AllocationTraceRecord& record);
+
+	// Reads every event from a trace, or nothing if the stream does not hold a trace of this version.
+	// A truncated final event, as left by a process which did not exit cleanly, is ignored.
+	Core::Optional<std::vector<AllocationTraceRecord>> ReadAllocationTrace(std::istream& stream);
+}
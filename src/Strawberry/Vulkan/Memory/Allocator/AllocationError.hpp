@@ -13,6 +13,9 @@ namespace Strawberry::Vulkan
         // Error for when an allocator cannot service a request because it is larger than this allocator can support.
         struct InsufficientPoolSize {};
 
+        // Error for when a pool allocator is given a request which the driver requires to have memory of its own.
+        struct RequiresDedicatedAllocation {};
+
 
         template<typename T>
         explicit AllocationError(T&& info)
@@ -42,7 +45,7 @@ namespace Strawberry::Vulkan
 
 
     private:
-        using Info = Core::Variant<OutOfMemory, InsufficientPoolSize>;
+        using Info = Core::Variant<OutOfMemory, InsufficientPoolSize, RequiresDedicatedAllocation>;
         Info mInfo;
     };
 }
\ No newline at end of file
@@ -6,6 +6,26 @@
 
 namespace Strawberry::Vulkan
 {
+	// How a resource lays out its memory, which decides whether it may share a page of
+	// VkPhysicalDeviceLimits::bufferImageGranularity bytes with its neighbours.
+	enum class ResourceKind : uint8_t
+	{
+		// Not known, so assumed to conflict with everything, including other resources of unknown kind.
+		Unknown,
+		// Buffers, and images with linear tiling.
+		Linear,
+		// Images with optimal tiling.
+		Optimal,
+	};
+
+
+	// Returns whether resources of the given kinds must be kept on separate bufferImageGranularity pages.
+	constexpr bool ResourceKindsConflict(ResourceKind a, ResourceKind b) noexcept
+	{
+		return a != b || a == ResourceKind::Unknown;
+	}
+
+
 	struct AllocationRequest
 	{
 		AllocationRequest(size_t size, size_t alignment)
@@ -25,8 +45,39 @@ namespace Strawberry::Vulkan
 			, typeMask(requirements.memoryTypeBits) {}
 
 
+		// Asks for this allocation to be given its own device memory, dedicated to the given resource. If it is
+		// required, the allocation must not be suballocated at all, rather than merely preferring not to be.
+		AllocationRequest& WithDedicatedBuffer(VkBuffer buffer, bool required = false) { dedicatedBuffer = buffer; requiresDedicated = required; return *this; }
+		AllocationRequest& WithDedicatedImage(VkImage image, bool required = false) { dedicatedImage = image; requiresDedicated = required; return *this; }
+
+
+		// Declares the kind of resource this allocation will be bound to.
+		AllocationRequest& WithResourceKind(ResourceKind kind) { resourceKind = kind; return *this; }
+
+
+		// Sets how important it is that this allocation stays in device local memory, from 0 to 1.
+		AllocationRequest& WithPriority(float value) { priority = value; return *this; }
+
+
+		[[nodiscard]] bool IsDedicated() const noexcept
+		{
+			return dedicatedBuffer != VK_NULL_HANDLE || dedicatedImage != VK_NULL_HANDLE;
+		}
+
+
 		size_t                         size;
 		size_t                         alignment;
 		uint32_t                       typeMask = -1;
+		// The resource this allocation should be dedicated to, if the driver prefers or requires it.
+		// Only allocators which make their own device memory per allocation honour these.
+		VkBuffer                       dedicatedBuffer = VK_NULL_HANDLE;
+		VkImage                        dedicatedImage  = VK_NULL_HANDLE;
+		// Pool allocators refuse requests which require dedicated memory with RequiresDedicatedAllocation.
+		bool                           requiresDedicated = false;
+		// Suballocators keep resources of conflicting kinds off each other's bufferImageGranularity pages.
+		ResourceKind                   resourceKind    = ResourceKind::Unknown;
+		// Passed to the driver with VK_EXT_memory_priority where the device has it. Like dedication, only allocators
+		// which make their own device memory per allocation honour this.
+		float                          priority        = 0.5f;
 	};
 }
\ No newline at end of file
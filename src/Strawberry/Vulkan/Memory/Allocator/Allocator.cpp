@@ -13,21 +13,29 @@ namespace Strawberry::Vulkan
 	Allocator::Allocator(Device& device)
 		: mDevice(device) {}
 
+	Allocator::Allocator(Device* device)
+		: mDevice(device ? Core::ReflexivePointer<Device>(*device) : Core::ReflexivePointer<Device>(nullptr)) {}
+
 	MemoryBlock::MemoryBlock(Allocator&  allocator,
 						   MemoryPool& allocation,
 						   size_t      offset,
-						   size_t      size)
+						   size_t      size,
+						   uint32_t    handle)
 		: mAllocator(allocator)
+		  , mOwner(allocator)
 		  , mMemoryPool(allocation)
 		  , mOffset(offset)
-		  , mSize(size) {}
+		  , mSize(size)
+		  , mHandle(handle) {}
 
 
 	MemoryBlock::MemoryBlock(MemoryBlock&& other) noexcept
 		: mAllocator(std::move(other.mAllocator))
+		  , mOwner(std::move(other.mOwner))
 		  , mMemoryPool(std::move(other.mMemoryPool))
 		  , mOffset(other.mOffset)
-		  , mSize(other.mSize) {}
+		  , mSize(other.mSize)
+		  , mHandle(other.mHandle) {}
 
 
 	MemoryBlock& MemoryBlock::operator=(MemoryBlock&& other) noexcept
@@ -48,6 +56,15 @@ namespace Strawberry::Vulkan
 		{
 			auto allocator = mAllocator.Get();
 			allocator->Free(std::move(*this));
+
+			// Only release our share of the pool once the block is back with its allocator, so that the pool never
+			// looks empty while it is still in use. The pool may have been destroyed by freeing, but is otherwise
+			// kept alive by our share.
+			if (mMemoryPool)
+			{
+				mMemoryPool->mAllocatedBlockCount -= 1;
+				mMemoryPool->mAllocatedBytes      -= mSize;
+			}
 		}
 	}
 
@@ -74,6 +91,18 @@ namespace Strawberry::Vulkan
 	}
 
 
+	Core::ReflexivePointer<Allocator> MemoryBlock::GetOwner() const noexcept
+	{
+		return mOwner;
+	}
+
+
+	Core::ReflexivePointer<MemoryPool> MemoryBlock::GetMemoryPool() const noexcept
+	{
+		return mMemoryPool;
+	}
+
+
 	Address MemoryBlock::Address() const noexcept
 	{
 		return {
@@ -101,6 +130,12 @@ namespace Strawberry::Vulkan
 	}
 
 
+	uint32_t MemoryBlock::Handle() const noexcept
+	{
+		return mHandle;
+	}
+
+
 	VkMemoryPropertyFlags MemoryBlock::Properties() const
 	{
 		return mMemoryPool->Properties();
@@ -113,17 +148,33 @@ namespace Strawberry::Vulkan
 	}
 
 
-	void MemoryBlock::Flush() const noexcept
+	void MemoryBlock::Flush(size_t offset, size_t size) const noexcept
 	{
-		VkMappedMemoryRange range
-		{
-			.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
-			.pNext = nullptr,
-			.memory = Memory(),
-			.offset = Offset(),
-			.size = VK_WHOLE_SIZE
-		};
-		Core::AssertEQ(vkFlushMappedMemoryRanges(static_cast<VkDevice>(mAllocator->GetDevice()), 1, &range), VK_SUCCESS);
+		if (Properties() & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) return;
+
+		const VkMappedMemoryRange range = MappedRange(offset, size);
+		if (range.size == 0) return;
+		Core::AssertEQ(vkFlushMappedMemoryRanges(GetDevice().Handle(), 1, &range), VK_SUCCESS);
+	}
+
+
+	void MemoryBlock::Invalidate(size_t offset, size_t size) const noexcept
+	{
+		if (Properties() & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) return;
+
+		const VkMappedMemoryRange range = MappedRange(offset, size);
+		if (range.size == 0) return;
+		Core::AssertEQ(vkInvalidateMappedMemoryRanges(GetDevice().Handle(), 1, &range), VK_SUCCESS);
+	}
+
+
+	VkMappedMemoryRange MemoryBlock::MappedRange(size_t offset, size_t size) const noexcept
+	{
+		Core::Assert(offset <= Size());
+		if (size == VK_WHOLE_SIZE) size = Size() - offset;
+		Core::Assert(offset + size <= Size());
+
+		return mMemoryPool->MappedRange(Offset() + offset, size);
 	}
 
 
@@ -131,9 +182,13 @@ namespace Strawberry::Vulkan
 	{
 		Core::Assert(bytes.Size() <= Size());
 		std::memcpy(GetMappedAddress(), bytes.Data(), bytes.Size());
-		if (!(Properties() & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
-		{
-			Flush();
-		}
+		Flush(0, bytes.Size());
+	}
+
+
+	void MemoryBlock::Reassign(Allocator& allocator) noexcept
+	{
+		Core::Assert(mAllocator);
+		mAllocator = Core::ReflexivePointer<Allocator>(allocator);
 	}
 }
@@ -18,11 +18,18 @@ namespace Strawberry::Vulkan
 	{
 	public:
 		Allocator(Device& device);
+		// The device may be null for allocators of pools which have none, see MemoryPool(MemoryTypeIndex, size_t).
+		Allocator(Device* device);
 
 
 		virtual void Free(MemoryBlock&& address) noexcept = 0;
 
 
+		// Returns whether blocks may be freed into this allocator from any thread. Blocks of allocators which are not
+		// are never freed by DeferredReleaseQueue::Collect(), see DeferredReleaseQueue::Reclaim().
+		[[nodiscard]] virtual bool IsThreadSafe() const noexcept { return false; }
+
+
 		[[nodiscard]]       Device& GetDevice()       { return *mDevice; }
 		[[nodiscard]] const Device& GetDevice() const { return *mDevice; }
 
@@ -0,0 +1,68 @@
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+#include "AllocatorStatistics.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/PoolAllocator.hpp"
+// Standard Library
+#include <algorithm>
+
+
+//======================================================================================================================
+//  Method Definitions
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	MemoryUsage MemoryUsage::Of(const MemoryPool& pool, const PoolAllocator* allocator)
+	{
+		MemoryUsage usage{
+			.deviceAllocationCount = 1,
+			.reservedBytes = pool.Size(),
+			.blockCount = pool.AllocatedBlockCount(),
+			.usedBytes = pool.AllocatedBytes(),
+		};
+
+		if (allocator)
+		{
+			allocator->VisitFreeRegions([&](size_t offset, size_t size)
+			{
+				usage.freeRegionCount   += 1;
+				usage.freeBytes         += size;
+				usage.largestFreeRegion  = std::max(usage.largestFreeRegion, size);
+			});
+		}
+
+		return usage;
+	}
+
+
+	double MemoryUsage::Fragmentation() const noexcept
+	{
+		if (freeBytes == 0)
+		{
+			return 0.0;
+		}
+
+		return 1.0 - static_cast<double>(largestFreeRegion) / static_cast<double>(freeBytes);
+	}
+
+
+	MemoryUsage& MemoryUsage::operator+=(const MemoryUsage& other) noexcept
+	{
+		deviceAllocationCount += other.deviceAllocationCount;
+		reservedBytes         += other.reservedBytes;
+		blockCount            += other.blockCount;
+		usedBytes             += other.usedBytes;
+		freeRegionCount       += other.freeRegionCount;
+		freeBytes             += other.freeBytes;
+		largestFreeRegion      = std::max(largestFreeRegion, other.largestFreeRegion);
+		return *this;
+	}
+
+
+	void MemoryPeaks::Update(const MemoryUsage& usage) noexcept
+	{
+		deviceAllocationCount = std::max(deviceAllocationCount, usage.deviceAllocationCount);
+		reservedBytes         = std::max(reservedBytes, usage.reservedBytes);
+		usedBytes             = std::max(usedBytes, usage.usedBytes);
+	}
+}
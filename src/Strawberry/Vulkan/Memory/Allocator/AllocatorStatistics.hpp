@@ -0,0 +1,87 @@
+#pragma once
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+// Vulkan
+#include <vulkan/vulkan.h>
+// Standard Library
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+
+//======================================================================================================================
+//  Class Declaration
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	class MemoryPool;
+	class PoolAllocator;
+
+
+	// Called with the offset and size of each free region of a pool, in address order.
+	using FreeRegionVisitor = std::function<void(size_t offset, size_t size)>;
+
+	// Called with each device memory allocation held by an allocator, along with the pool allocator which carves it
+	// up, or nullptr if it is handed out whole.
+	using PoolVisitor = std::function<void(const MemoryPool& pool, const PoolAllocator* allocator)>;
+
+
+	// How a set of device memory allocations is being used.
+	struct MemoryUsage
+	{
+		// The number of device memory allocations, each of which counts towards maxMemoryAllocationCount.
+		size_t deviceAllocationCount = 0;
+		// The total size of those allocations.
+		size_t reservedBytes         = 0;
+		// The number of live blocks, and the bytes that they cover.
+		size_t blockCount            = 0;
+		size_t usedBytes             = 0;
+		// The regions that new blocks can still be carved from. Alignment padding is neither used nor free.
+		size_t freeRegionCount       = 0;
+		size_t freeBytes             = 0;
+		size_t largestFreeRegion     = 0;
+
+
+		// Returns the usage of a single pool. Free regions are only counted if the allocator carving it is given.
+		static MemoryUsage Of(const MemoryPool& pool, const PoolAllocator* allocator);
+
+
+		// Returns how much of the free space is unusable for a single allocation of all of it, from 0 when the free
+		// space is one contiguous region, approaching 1 as it is scattered into many small regions.
+		double Fragmentation() const noexcept;
+
+
+		MemoryUsage& operator+=(const MemoryUsage& other) noexcept;
+	};
+
+
+	// The highest usage seen of some set of device memory allocations.
+	struct MemoryPeaks
+	{
+		size_t deviceAllocationCount = 0;
+		size_t reservedBytes         = 0;
+		size_t usedBytes             = 0;
+
+
+		// Raises each peak to the given usage, if it is higher.
+		void Update(const MemoryUsage& usage) noexcept;
+	};
+
+
+	// A snapshot of all the memory held by a PolyAllocator.
+	struct MemoryStatistics
+	{
+		std::array<MemoryUsage, VK_MAX_MEMORY_TYPES> types{};
+		std::array<MemoryUsage, VK_MAX_MEMORY_HEAPS> heaps{};
+		MemoryUsage                                  total;
+
+		// The highest usage seen since peak tracking was enabled, see PolyAllocator::SetPeakTracking().
+		std::array<MemoryPeaks, VK_MAX_MEMORY_HEAPS> heapPeaks{};
+		MemoryPeaks                                  totalPeaks;
+
+		// The device's limit on the number of device memory allocations which may exist at once.
+		uint32_t                                     maxMemoryAllocationCount = 0;
+	};
+}
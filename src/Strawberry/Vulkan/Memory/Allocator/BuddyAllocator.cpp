@@ -0,0 +1,152 @@
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+#include "BuddyAllocator.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+// Standard Library
+#include <algorithm>
+#include <bit>
+#include <utility>
+
+
+//======================================================================================================================
+//  Method Definitions
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	BuddyAllocator::BuddyAllocator(MemoryPool&& memoryPool, size_t minBlockSize)
+		: PoolAllocator(std::move(memoryPool))
+	{
+		Core::Assert(std::has_single_bit(minBlockSize));
+		Core::Assert(Memory().Size() >= minBlockSize);
+
+		mMinBlockSizeLog2 = std::countr_zero(minBlockSize);
+		mMaxOrder         = std::countr_zero(std::bit_floor(Memory().Size())) - mMinBlockSizeLog2;
+
+		// Initialise every node as fully free.
+		mTree.resize((size_t{2} << mMaxOrder) - 1);
+		NodeIndex levelStart = 0;
+		for (unsigned depth = 0; depth <= mMaxOrder; depth++)
+		{
+			const NodeIndex levelEnd = 2 * levelStart + 1;
+			std::fill(mTree.begin() + levelStart, mTree.begin() + levelEnd, static_cast<uint8_t>(mMaxOrder - depth + 1));
+			levelStart = levelEnd;
+		}
+	}
+
+
+	AllocationResult BuddyAllocator::Allocate(const AllocationRequest& allocationRequest) noexcept
+	{
+		if (allocationRequest.requiresDedicated) [[unlikely]]
+		{
+			return AllocationError::RequiresDedicatedAllocation{};
+		}
+
+		// Blocks are aligned to their size, so once conflicting kinds are mixed, a block of at least a whole
+		// bufferImageGranularity page can never share a page with anything else.
+		const size_t   alignment = MayConflict(allocationRequest.resourceKind)
+			? std::max<size_t>(allocationRequest.alignment, BufferImageGranularity())
+			: allocationRequest.alignment;
+		const unsigned order     = GetOrder(allocationRequest.size, alignment);
+		if (order > mMaxOrder) [[unlikely]]
+		{
+			return AllocationError::InsufficientPoolSize{};
+		}
+
+		// Make sure that this is one of the valid memory types for this allocation.
+		Core::Assert(allocationRequest.typeMask & (1 << Memory().GetMemoryTypeIndex().memoryTypeIndex));
+
+		if (mTree[0] < order + 1)
+		{
+			return AllocationError::OutOfMemory();
+		}
+
+		// Descend to a free node of the right order, preferring the left subtree to keep the pool compact.
+		NodeIndex node      = 0;
+		unsigned  nodeOrder = mMaxOrder;
+		while (nodeOrder != order)
+		{
+			node = mTree[LeftChild(node)] >= order + 1 ? LeftChild(node) : RightChild(node);
+			nodeOrder--;
+		}
+
+		mTree[node] = 0;
+		UpdateAncestors(node, order);
+
+		const NodeIndex firstNodeOfOrder = (size_t{1} << (mMaxOrder - order)) - 1;
+		const size_t    offset           = (node - firstNodeOfOrder) << (order + mMinBlockSizeLog2);
+		NoteResourceKind(allocationRequest.resourceKind);
+		return Memory().AllocateView(*this, offset, allocationRequest.size);
+	}
+
+
+	void BuddyAllocator::Free(MemoryBlock&& address) noexcept
+	{
+		// Climb from the leaf containing the offset until we reach the node that was allocated.
+		NodeIndex node  = (address.Offset() >> mMinBlockSizeLog2) + (size_t{1} << mMaxOrder) - 1;
+		unsigned  order = 0;
+		while (mTree[node] != 0)
+		{
+			Core::Assert(node != 0);
+			node = Parent(node);
+			order++;
+		}
+
+		mTree[node] = static_cast<uint8_t>(order + 1);
+		UpdateAncestors(node, order);
+	}
+
+
+	void BuddyAllocator::VisitFreeRegions(const FreeRegionVisitor& visitor) const
+	{
+		// Walk the tree in address order, stopping at nodes which are either wholly free or wholly allocated.
+		std::vector<std::pair<NodeIndex, unsigned>> stack{{0, mMaxOrder}};
+		while (!stack.empty())
+		{
+			const auto [node, order] = stack.back();
+			stack.pop_back();
+
+			if (mTree[node] == order + 1)
+			{
+				const NodeIndex firstNodeOfOrder = (size_t{1} << (mMaxOrder - order)) - 1;
+				visitor((node - firstNodeOfOrder) << (order + mMinBlockSizeLog2), size_t{1} << (order + mMinBlockSizeLog2));
+			}
+			else if (mTree[node] != 0)
+			{
+				stack.emplace_back(RightChild(node), order - 1);
+				stack.emplace_back(LeftChild(node), order - 1);
+			}
+		}
+	}
+
+
+	unsigned BuddyAllocator::GetOrder(size_t size, size_t alignment) const noexcept
+	{
+		// Blocks are aligned to their size, so a block at least as large as the alignment is always suitably aligned.
+		const size_t blockSize = std::bit_ceil(std::max({size, alignment, size_t{1} << mMinBlockSizeLog2}));
+		return std::countr_zero(blockSize) - mMinBlockSizeLog2;
+	}
+
+
+	void BuddyAllocator::UpdateAncestors(NodeIndex node, unsigned order) noexcept
+	{
+		while (node != 0)
+		{
+			node = Parent(node);
+			order++;
+
+			const uint8_t left  = mTree[LeftChild(node)];
+			const uint8_t right = mTree[RightChild(node)];
+			// Merge buddies which are both entirely free.
+			if (left == order && right == order)
+			{
+				mTree[node] = static_cast<uint8_t>(order + 1);
+			}
+			else
+			{
+				mTree[node] = std::max(left, right);
+			}
+		}
+	}
+}
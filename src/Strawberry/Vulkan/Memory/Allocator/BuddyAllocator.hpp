@@ -0,0 +1,69 @@
+#pragma once
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+// Strawberry Vulkan
+#include "Strawberry/Vulkan/Memory/Allocator/PoolAllocator.hpp"
+// Standard Library
+#include <cstdint>
+#include <vector>
+
+
+//======================================================================================================================
+//  Class Declaration
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	// Binary buddy allocator.
+	//
+	// Allocations are rounded up to a power of two and served from blocks which are recursively halved from the whole
+	// pool. Every block is naturally aligned to its own size. The state of the pool is kept in an implicit binary tree
+	// of bytes, where each node records the order of the largest free block within its subtree, so both allocating
+	// and freeing walk a single root to leaf path.
+	//
+	// If the pool size is not a power of two, only the largest power of two prefix of it is used.
+	//
+	// Once linear and optimal resources are mixed in the pool, every further block is at least a whole
+	// bufferImageGranularity page, so that no two blocks sharing a page can be of conflicting kinds.
+	class BuddyAllocator
+			: public PoolAllocator
+	{
+	public:
+		// The size of the smallest block that will be handed out.
+		static constexpr size_t DEFAULT_MIN_BLOCK_SIZE = 256;
+
+
+		BuddyAllocator(MemoryPool&& memoryPool, size_t minBlockSize = DEFAULT_MIN_BLOCK_SIZE);
+
+
+		AllocationResult Allocate(const AllocationRequest& allocationRequest) noexcept override;
+
+		void Free(MemoryBlock&& address) noexcept override;
+
+		void VisitFreeRegions(const FreeRegionVisitor& visitor) const override;
+
+	private:
+		using NodeIndex = size_t;
+
+
+		// Returns the order of the smallest block which satisfies the given size and alignment.
+		unsigned GetOrder(size_t size, size_t alignment) const noexcept;
+
+		// Recomputes the value of each ancestor of the given node of the given order.
+		void UpdateAncestors(NodeIndex node, unsigned order) noexcept;
+
+
+		static NodeIndex Parent(NodeIndex node) noexcept { return (node - 1) / 2; }
+		static NodeIndex LeftChild(NodeIndex node) noexcept { return 2 * node + 1; }
+		static NodeIndex RightChild(NodeIndex node) noexcept { return 2 * node + 2; }
+
+
+		// log2 of the minimum block size.
+		unsigned             mMinBlockSizeLog2;
+		// The order of the root block, where a block of order n is (minimum block size << n) bytes.
+		unsigned             mMaxOrder;
+		// For each node of the tree, one more than the order of the largest free block in its subtree, or 0 if the
+		// subtree is fully allocated. Nodes below an allocated node are left as they were when it was allocated.
+		std::vector<uint8_t> mTree;
+	};
+}
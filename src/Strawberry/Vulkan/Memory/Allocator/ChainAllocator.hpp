@@ -1,47 +1,110 @@
 #pragma once
 #include "PoolAllocator.hpp"
 #include "MonoAllocator.hpp"
-#include <unordered_set>
+#include "Strawberry/Core/Assert.hpp"
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <vector>
 
 
 
 namespace Strawberry::Vulkan
 {
+	// Describes how large each new pool in a ChainAllocator is.
+	//
+	// The first pool is initialPoolSize bytes, and each following pool is growthFactor times larger than the last, up
+	// to maxPoolSize. Requests larger than maxPoolSize are refused with InsufficientPoolSize, so that they can be given
+	// memory of their own.
+	struct ChainGrowthPolicy
+	{
+		size_t initialPoolSize;
+		size_t maxPoolSize;
+		size_t growthFactor = 2;
+
+
+		// Every pool is the same size.
+		static ChainGrowthPolicy Fixed(size_t poolSize)
+		{
+			return {.initialPoolSize = poolSize, .maxPoolSize = poolSize, .growthFactor = 1};
+		}
+
+
+		// Pools double in size from initialPoolSize until they reach maxPoolSize.
+		static ChainGrowthPolicy Geometric(size_t initialPoolSize, size_t maxPoolSize)
+		{
+			return {.initialPoolSize = initialPoolSize, .maxPoolSize = maxPoolSize, .growthFactor = 2};
+		}
+
+
+		// Derives pool sizes from the size of the heap they are allocated from. Small heaps, such as the host visible
+		// window of device memory without ReBAR, are split into eighths, whilst large heaps use pools of up to
+		// LARGE_HEAP_MAX_POOL_SIZE. Either way the first pool is an eighth of the largest.
+		static ChainGrowthPolicy ForHeap(size_t heapSize)
+		{
+			const size_t maxPoolSize = heapSize <= SMALL_HEAP_SIZE
+				? std::bit_floor(heapSize / 8)
+				: LARGE_HEAP_MAX_POOL_SIZE;
+			return Geometric(std::min(std::max(maxPoolSize / 8, MIN_POOL_SIZE), maxPoolSize), maxPoolSize);
+		}
+
+
+		static constexpr size_t SMALL_HEAP_SIZE          = size_t{1} << 30;
+		static constexpr size_t LARGE_HEAP_MAX_POOL_SIZE = 256 * 1024 * 1024;
+		static constexpr size_t MIN_POOL_SIZE            = 1024 * 1024;
+	};
+
+
+	// Describes when a ChainAllocator returns pools which have become empty to the device.
+	//
+	// A pool is released once it has been empty for idleFrameCount consecutive frames, except that up to
+	// spareEmptyPools empty pools are always kept to absorb the next spike without calling vkAllocateMemory again.
+	struct ChainTrimPolicy
+	{
+		size_t   spareEmptyPools = 1;
+		unsigned idleFrameCount  = 120;
+	};
+
+
 	template <std::derived_from<PoolAllocator> T>
 	class ChainAllocator
 		: public MonoAllocator
 	{
 	public:
-		ChainAllocator(Device& device, MemoryTypeIndex memoryTypeIndex, size_t poolSize) noexcept
+		ChainAllocator(Device& device, MemoryTypeIndex memoryTypeIndex, ChainGrowthPolicy growthPolicy, ChainTrimPolicy trimPolicy = {}) noexcept
 			: MonoAllocator(device, memoryTypeIndex)
-			, mPoolSize(poolSize)
+			, mGrowthPolicy(growthPolicy)
+			, mTrimPolicy(trimPolicy)
+			, mNextPoolSize(growthPolicy.initialPoolSize)
 		{
-			ExtendChain();
+			Core::Assert(growthPolicy.initialPoolSize <= growthPolicy.maxPoolSize);
+			ExtendChain(0);
 		}
 
+		ChainAllocator(Device& device, MemoryTypeIndex memoryTypeIndex, size_t poolSize) noexcept
+			: ChainAllocator(device, memoryTypeIndex, ChainGrowthPolicy::Fixed(poolSize)) {}
+
 		void Free(MemoryBlock&& allocation) noexcept override
 		{
-			for (auto& allocator : mAllocatorChain)
-			{
-				if (allocator.allocations.contains(allocation.Address()))
-				{
-					allocator.allocator.Free(std::move(allocation));
-				}
-			}
-
-			Core::Unreachable();
+			// Blocks point straight at the pool allocator in the chain which produced them.
+			Core::Assert(allocation.GetAllocator().Get() != this);
+			allocation.GetAllocator()->Free(std::move(allocation));
 		}
 
 
 		AllocationResult Allocate(const AllocationRequest& allocationRequest) noexcept override
 		{
-			for (auto& allocator : mAllocatorChain)
+			if (allocationRequest.size > mGrowthPolicy.maxPoolSize) [[unlikely]]
 			{
-				auto result = allocator.allocator.Allocate(allocationRequest);
+				return AllocationError::InsufficientPoolSize{};
+			}
+
+			for (auto& pool : mAllocatorChain)
+			{
+				auto result = pool->allocator.Allocate(allocationRequest);
 
 				if (result)
 				{
-					allocator.allocations.emplace(result.Value().Address());
 					return result;
 				}
 
@@ -51,35 +114,120 @@ namespace Strawberry::Vulkan
 				}
 			}
 
-			ExtendChain();
-			return mAllocatorChain.back().allocator.Allocate(allocationRequest);
+			// The pool's allocator may need up to alignment - 1 bytes of slack to find an aligned fit for the request, but
+			// a request which fills a whole pool can still be placed at its start.
+			const size_t required = std::min(allocationRequest.size + allocationRequest.alignment - 1, mGrowthPolicy.maxPoolSize);
+			if (!ExtendChain(required))
+			{
+				return AllocationError::OutOfMemory();
+			}
+			return mAllocatorChain.back()->allocator.Allocate(allocationRequest);
+		}
+
+
+		// Advances the frame count used for deciding when empty pools are released, and releases those which have
+		// been idle for long enough under the trim policy.
+		void NextFrame() noexcept;
+
+		// Immediately releases every empty pool, regardless of the trim policy.
+		void Trim() noexcept;
+
+
+		void VisitPools(const PoolVisitor& visitor) const override
+		{
+			for (const auto& pool : mAllocatorChain)
+			{
+				pool->allocator.VisitPools(visitor);
+			}
 		}
 
 
+		// Returns the number of pools, and therefore the number of device memory allocations, in this chain.
+		size_t PoolCount() const noexcept { return mAllocatorChain.size(); }
+
+
 	private:
-		void ExtendChain();
+		// Appends a new pool of at least the given size, rounded up by the growth policy. Returns false if the device
+		// could not provide one.
+		bool ExtendChain(size_t minimumSize);
+
+		// Returns each pool in the chain for which the given predicate is true to the device.
+		template <typename F>
+		void ReleasePools(F&& shouldRelease);
 
 
-		struct ChainItem
+		struct Pool
 		{
-			std::unordered_set<Address> allocations;
-			T allocator;
+			T        allocator;
+			// How many consecutive frames this pool has been empty for.
+			unsigned idleFrames = 0;
 		};
 
 
-		size_t mPoolSize;
-		std::vector<ChainItem> mAllocatorChain;
+		ChainGrowthPolicy                  mGrowthPolicy;
+		ChainTrimPolicy                    mTrimPolicy;
+		// The size of the next pool to be created, before accounting for the request which needs it.
+		size_t                             mNextPoolSize;
+		// Pools are kept behind pointers so that they never move once created. Blocks may then be destroyed without
+		// any lock whilst the chain grows, see ConcurrentPolyAllocator.
+		std::vector<std::unique_ptr<Pool>> mAllocatorChain;
 	};
 
 
 	template <std::derived_from<PoolAllocator> T>
-	void ChainAllocator<T>::ExtendChain()
+	void ChainAllocator<T>::NextFrame() noexcept
 	{
-		ChainItem item {
-			.allocations{},
-			.allocator{ T(MemoryPool::Allocate(GetDevice(), GetMemoryTypeIndex(), mPoolSize).Unwrap()) }
-		};
+		size_t emptyPoolCount = 0;
+		for (auto& pool : mAllocatorChain)
+		{
+			pool->idleFrames = pool->allocator.Memory().IsEmpty() ? pool->idleFrames + 1 : 0;
+		}
+
+		// Pools are visited in allocation order, so the earliest empty pools are the ones kept as spares.
+		ReleasePools([&](const Pool& pool)
+		{
+			return pool.idleFrames > 0
+				&& ++emptyPoolCount > mTrimPolicy.spareEmptyPools
+				&& pool.idleFrames >= mTrimPolicy.idleFrameCount;
+		});
+	}
+
+
+	template <std::derived_from<PoolAllocator> T>
+	void ChainAllocator<T>::Trim() noexcept
+	{
+		ReleasePools([](const Pool& pool) { return pool.allocator.Memory().IsEmpty(); });
+	}
+
+
+	template <std::derived_from<PoolAllocator> T>
+	template <typename F>
+	void ChainAllocator<T>::ReleasePools(F&& shouldRelease)
+	{
+		// Pools are visited exactly once each, in order.
+		std::erase_if(mAllocatorChain, [&](const std::unique_ptr<Pool>& pool) { return shouldRelease(*pool); });
+	}
+
+
+	template <std::derived_from<PoolAllocator> T>
+	bool ChainAllocator<T>::ExtendChain(size_t minimumSize)
+	{
+		const size_t poolSize = std::clamp(std::bit_ceil(minimumSize), mNextPoolSize, mGrowthPolicy.maxPoolSize);
+
+		// If the device cannot provide a pool of the size we would like, settle for smaller ones as long as they still
+		// fit the request.
+		const size_t smallestPoolSize = std::max(minimumSize, std::min(poolSize, ChainGrowthPolicy::MIN_POOL_SIZE));
+		for (size_t size = poolSize; size >= smallestPoolSize; size /= 2)
+		{
+			auto memoryPool = MemoryPool::Allocate(GetDevice(), GetMemoryTypeIndex(), size);
+			if (memoryPool)
+			{
+				mAllocatorChain.emplace_back(std::make_unique<Pool>(Pool{.allocator = T(memoryPool.Unwrap())}));
+				mNextPoolSize = std::min(mNextPoolSize * mGrowthPolicy.growthFactor, mGrowthPolicy.maxPoolSize);
+				return true;
+			}
+		}
 
-		mAllocatorChain.emplace_back(std::move(item));
+		return false;
 	}
 }
@@ -0,0 +1,443 @@
+#pragma once
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+// Strawberry Vulkan
+#include "Strawberry/Vulkan/Memory/Allocator/ChainAllocator.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/MonoAllocator.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/PolyAllocator.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/SlabAllocator.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+// Standard Library
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+//======================================================================================================================
+//  Class Declaration
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	// Thread safe allocator, so that resources can be created from many threads at once.
+	//
+	// Each memory type has its own set of allocators behind its own lock, so threads only contend when they allocate
+	// from the same memory type at the same moment. Small requests are served from magazines: caches of slab slots of a
+	// single size, of which every thread is assigned its own in turn. Allocating and freeing small blocks therefore
+	// only takes an uncontended lock, and the memory type's allocators are only touched to refill a magazine which has
+	// run dry, or to return blocks from one which has overflowed.
+	//
+	// Memory types are chosen in the same way as NaivePolyAllocator, avoiding heaps which are close to their budget, see
+	// PolyAllocator::GetMemoryTypeOrder().
+	// Every block handed out is returned through this allocator, which passes it on to the allocator that carved it,
+	// see MemoryBlock::GetOwner().
+	template<std::derived_from<MonoAllocator> Base>
+	class ConcurrentPolyAllocator
+			: public PolyAllocator
+	{
+	public:
+		// The size of each memory pool requested from the device for small allocations.
+		static constexpr size_t SMALL_POOL_SIZE       = 4 * 1024 * 1024;
+		// The number of magazines for each slot size. Up to this many threads never share one.
+		static constexpr size_t MAGAZINE_COUNT        = 16;
+		// The number of freed blocks a magazine keeps before returning further ones to the slab allocators.
+		static constexpr size_t MAGAZINE_CAPACITY     = 64;
+		// The number of blocks taken from the slab allocators at once when a magazine is empty.
+		static constexpr size_t MAGAZINE_REFILL_COUNT = 16;
+
+
+		explicit ConcurrentPolyAllocator(Device& device)
+			: PolyAllocator(device) {}
+
+		~ConcurrentPolyAllocator() override = default;
+
+
+		AllocationResult Allocate(const AllocationRequest&  allocationRequest,
+								  const MemoryTypeCriteria& memoryTypeCriteria) noexcept override;
+
+		void Free(MemoryBlock&& address) noexcept override;
+
+		[[nodiscard]] bool IsThreadSafe() const noexcept override { return true; }
+
+
+		// Releases pools which have been empty for long enough. Blocks held in magazines are left where they are.
+		void NextFrame() noexcept override;
+
+		// Returns every block held in a magazine to the slab allocators, and then releases every empty pool.
+		void Trim() noexcept override;
+
+
+		// Visits each memory type's pools with its lock held. Slots cached in magazines are counted as used.
+		void VisitPools(const PoolVisitor& visitor) const override;
+
+	private:
+		static constexpr size_t SLOT_SIZE_COUNT     = std::countr_zero(SlabAllocator::MAX_OBJECT_SIZE)
+		                                            - std::countr_zero(SlabAllocator::MIN_OBJECT_SIZE) + 1;
+		static constexpr size_t RESOURCE_KIND_COUNT = 3;
+
+
+		class SlotCache;
+
+
+		// Everything belonging to a single memory type, all guarded by mutex.
+		struct Shard
+		{
+			Shard(Device& device, MemoryTypeIndex typeIndex, ChainGrowthPolicy growthPolicy)
+				: allocator{ { device, typeIndex, growthPolicy } } {}
+
+
+			// Returns the slab allocator, creating it the first time it is needed.
+			ChainAllocator<SlabAllocator>& GetSmallAllocator(Device& device, MemoryTypeIndex typeIndex);
+
+
+			std::mutex                                    mutex;
+			Base                                          allocator;
+			Core::Optional<ChainAllocator<SlabAllocator>> smallAllocator;
+
+			// Slot caches by resource kind and slot size. Created under the lock, but read without it.
+			std::array<std::array<std::atomic<SlotCache*>, SLOT_SIZE_COUNT>, RESOURCE_KIND_COUNT> slotCaches{};
+			std::vector<std::unique_ptr<SlotCache>>                                               ownedSlotCaches;
+		};
+
+
+		// The magazines for one slot size, resource kind and memory type. Blocks handed out of them are returned here.
+		class SlotCache
+				: public Allocator
+		{
+		public:
+			SlotCache(Device& device, Shard& shard, MemoryTypeIndex typeIndex, const AllocationRequest& slotRequest)
+				: Allocator(device)
+				, mShard(shard)
+				, mTypeIndex(typeIndex)
+				, mSlotRequest(slotRequest) {}
+
+			~SlotCache() override { Flush(); }
+
+
+			// Takes a block from the calling thread's magazine, refilling it from the slab allocators if it is empty.
+			AllocationResult Allocate() noexcept;
+
+			// Keeps the block in the calling thread's magazine, unless it is already full.
+			void Free(MemoryBlock&& address) noexcept override;
+
+			// Returns every block held in the magazines to the slab allocators.
+			void Flush() noexcept;
+
+
+		private:
+			struct Magazine
+			{
+				std::mutex               mutex;
+				std::vector<MemoryBlock> blocks;
+			};
+
+
+			Shard&                                 mShard;
+			MemoryTypeIndex                        mTypeIndex;
+			AllocationRequest                      mSlotRequest;
+			std::array<Magazine, MAGAZINE_COUNT>   mMagazines;
+		};
+
+
+		// Returns the index of the magazine the calling thread uses, assigned in turn the first time it is asked.
+		static size_t GetThreadMagazineIndex() noexcept;
+
+
+		// Returns the shard for the given memory type, creating it the first time it is needed.
+		Shard& GetShard(MemoryTypeIndex typeIndex);
+
+		// Returns the slot cache which serves the given small request from the given shard.
+		SlotCache& GetSlotCache(Shard& shard, MemoryTypeIndex typeIndex, const AllocationRequest& allocationRequest);
+
+
+		// Allocates from the given memory type, preferring magazines for small requests.
+		AllocationResult AllocateFromType(MemoryTypeIndex typeIndex, const AllocationRequest& allocationRequest) noexcept;
+
+
+		// Shards are created at most once each, and never destroyed before this allocator.
+		std::array<std::once_flag, VK_MAX_MEMORY_TYPES>         mShardCreated;
+		std::array<std::atomic<Shard*>, VK_MAX_MEMORY_TYPES>    mShards{};
+		std::array<std::unique_ptr<Shard>, VK_MAX_MEMORY_TYPES> mOwnedShards;
+	};
+
+
+	template<std::derived_from<MonoAllocator> Base>
+	AllocationResult ConcurrentPolyAllocator<Base>::Allocate(
+		const AllocationRequest&  allocationRequest,
+		const MemoryTypeCriteria& memoryTypeCriteria) noexcept
+	{
+		const MemoryTypeOrder order = GetMemoryTypeOrder(allocationRequest, memoryTypeCriteria);
+		if (order.count == 0) [[unlikely]]
+		{
+			return AllocationError::OutOfMemory();
+		}
+
+		for (size_t i = 0; i + 1 < order.count; i++)
+		{
+			if (auto result = AllocateFromType(order.types[i], allocationRequest))
+			{
+				return result;
+			}
+
+			// Something failed, so our view of the heaps is probably out of date.
+			InvalidateHeapBudgets();
+		}
+
+		return AllocateFromType(order.types[order.count - 1], allocationRequest);
+	}
+
+
+	template<std::derived_from<MonoAllocator> Base>
+	void ConcurrentPolyAllocator<Base>::Free(MemoryBlock&& address) noexcept
+	{
+		Core::Assert(address.GetAllocator().Get() == this);
+
+		Shard& shard = GetShard(address.GetMemoryPool()->GetMemoryTypeIndex());
+		std::scoped_lock lock(shard.mutex);
+		address.GetOwner()->Free(std::move(address));
+	}
+
+
+	template<std::derived_from<MonoAllocator> Base>
+	void ConcurrentPolyAllocator<Base>::NextFrame() noexcept
+	{
+		for (std::atomic<Shard*>& shardPointer : mShards)
+		{
+			if (Shard* shard = shardPointer.load(std::memory_order_acquire))
+			{
+				std::scoped_lock lock(shard->mutex);
+				shard->allocator.NextFrame();
+				if (shard->smallAllocator) shard->smallAllocator->NextFrame();
+			}
+		}
+
+		SamplePeaks();
+	}
+
+
+	template<std::derived_from<MonoAllocator> Base>
+	void ConcurrentPolyAllocator<Base>::Trim() noexcept
+	{
+		for (std::atomic<Shard*>& shardPointer : mShards)
+		{
+			Shard* shard = shardPointer.load(std::memory_order_acquire);
+			if (!shard)
+			{
+				continue;
+			}
+
+			// Magazines are always locked before the shard, so collect them first and flush them without the shard locked.
+			std::vector<SlotCache*> slotCaches;
+			{
+				std::scoped_lock lock(shard->mutex);
+				for (const auto& slotCache : shard->ownedSlotCaches)
+				{
+					slotCaches.emplace_back(slotCache.get());
+				}
+			}
+			for (SlotCache* slotCache : slotCaches)
+			{
+				slotCache->Flush();
+			}
+
+			std::scoped_lock lock(shard->mutex);
+			shard->allocator.Trim();
+			if (shard->smallAllocator) shard->smallAllocator->Trim();
+		}
+	}
+
+
+	template<std::derived_from<MonoAllocator> Base>
+	void ConcurrentPolyAllocator<Base>::VisitPools(const PoolVisitor& visitor) const
+	{
+		for (const std::atomic<Shard*>& shardPointer : mShards)
+		{
+			if (Shard* shard = shardPointer.load(std::memory_order_acquire))
+			{
+				std::scoped_lock lock(shard->mutex);
+				shard->allocator.VisitPools(visitor);
+				if (shard->smallAllocator) shard->smallAllocator->VisitPools(visitor);
+			}
+		}
+	}
+
+
+	template<std::derived_from<MonoAllocator> Base>
+	size_t ConcurrentPolyAllocator<Base>::GetThreadMagazineIndex() noexcept
+	{
+		static std::atomic<size_t> nextIndex = 0;
+		thread_local const size_t  index     = nextIndex.fetch_add(1, std::memory_order_relaxed) % MAGAZINE_COUNT;
+		return index;
+	}
+
+
+	template<std::derived_from<MonoAllocator> Base>
+	typename ConcurrentPolyAllocator<Base>::Shard& ConcurrentPolyAllocator<Base>::GetShard(MemoryTypeIndex typeIndex)
+	{
+		const uint32_t index = typeIndex.memoryTypeIndex;
+		std::call_once(mShardCreated[index], [&]
+		{
+			const auto& memoryProperties = GetDevice().GetPhysicalDevice().GetMemoryProperties();
+			const auto  heapIndex        = memoryProperties.memoryTypes[index].heapIndex;
+			const auto  growthPolicy     = ChainGrowthPolicy::ForHeap(memoryProperties.memoryHeaps[heapIndex].size);
+			mOwnedShards[index] = std::make_unique<Shard>(GetDevice(), typeIndex, growthPolicy);
+			mShards[index].store(mOwnedShards[index].get(), std::memory_order_release);
+		});
+
+		return *mOwnedShards[index];
+	}
+
+
+	template<std::derived_from<MonoAllocator> Base>
+	typename ConcurrentPolyAllocator<Base>::SlotCache& ConcurrentPolyAllocator<Base>::GetSlotCache(
+		Shard&                   shard,
+		MemoryTypeIndex          typeIndex,
+		const AllocationRequest& allocationRequest)
+	{
+		const size_t slotSize  = SlabAllocator::GetSlotSize(allocationRequest);
+		const size_t slotIndex = std::countr_zero(slotSize) - std::countr_zero(SlabAllocator::MIN_OBJECT_SIZE);
+		auto&        slot      = shard.slotCaches[static_cast<size_t>(allocationRequest.resourceKind)][slotIndex];
+
+		SlotCache* slotCache = slot.load(std::memory_order_acquire);
+		if (!slotCache) [[unlikely]]
+		{
+			std::scoped_lock lock(shard.mutex);
+			slotCache = slot.load(std::memory_order_relaxed);
+			if (!slotCache)
+			{
+				// Every block in the cache spans a whole slot, so that it can be handed out for any request of this size.
+				const AllocationRequest slotRequest = AllocationRequest(slotSize, slotSize)
+					.WithResourceKind(allocationRequest.resourceKind);
+				slotCache = shard.ownedSlotCaches.emplace_back(
+					std::make_unique<SlotCache>(GetDevice(), shard, typeIndex, slotRequest)).get();
+				slot.store(slotCache, std::memory_order_release);
+			}
+		}
+
+		return *slotCache;
+	}
+
+
+	template<std::derived_from<MonoAllocator> Base>
+	AllocationResult ConcurrentPolyAllocator<Base>::AllocateFromType(
+		MemoryTypeIndex          typeIndex,
+		const AllocationRequest& allocationRequest) noexcept
+	{
+		Shard& shard = GetShard(typeIndex);
+
+		// Serve small requests from magazines, falling back on the general allocator if they cannot be served there.
+		if (SlabAllocator::IsSmallAllocation(allocationRequest) && !allocationRequest.IsDedicated())
+		{
+			if (auto result = GetSlotCache(shard, typeIndex, allocationRequest).Allocate())
+			{
+				return result;
+			}
+		}
+
+		std::scoped_lock lock(shard.mutex);
+		AllocationResult result = shard.allocator.Allocate(allocationRequest);
+		if (!result)
+		{
+			return result;
+		}
+
+		MemoryBlock block = result.Unwrap();
+		block.Reassign(*this);
+		return block;
+	}
+
+
+	template<std::derived_from<MonoAllocator> Base>
+	ChainAllocator<SlabAllocator>& ConcurrentPolyAllocator<Base>::Shard::GetSmallAllocator(Device& device, MemoryTypeIndex typeIndex)
+	{
+		if (!smallAllocator) [[unlikely]]
+		{
+			smallAllocator.Emplace(device, typeIndex, SMALL_POOL_SIZE);
+		}
+
+		return smallAllocator.Value();
+	}
+
+
+	template<std::derived_from<MonoAllocator> Base>
+	AllocationResult ConcurrentPolyAllocator<Base>::SlotCache::Allocate() noexcept
+	{
+		Magazine& magazine = mMagazines[GetThreadMagazineIndex()];
+		std::scoped_lock magazineLock(magazine.mutex);
+
+		if (magazine.blocks.empty())
+		{
+			std::scoped_lock shardLock(mShard.mutex);
+			auto& smallAllocator = mShard.GetSmallAllocator(GetDevice(), mTypeIndex);
+			for (size_t i = 0; i < MAGAZINE_REFILL_COUNT; i++)
+			{
+				AllocationResult result = smallAllocator.Allocate(mSlotRequest);
+				if (!result)
+				{
+					break;
+				}
+
+				MemoryBlock block = result.Unwrap();
+				block.Reassign(*this);
+				magazine.blocks.emplace_back(std::move(block));
+			}
+
+			if (magazine.blocks.empty())
+			{
+				return AllocationError::OutOfMemory();
+			}
+		}
+
+		MemoryBlock block = std::move(magazine.blocks.back());
+		magazine.blocks.pop_back();
+		return block;
+	}
+
+
+	template<std::derived_from<MonoAllocator> Base>
+	void ConcurrentPolyAllocator<Base>::SlotCache::Free(MemoryBlock&& address) noexcept
+	{
+		Magazine& magazine = mMagazines[GetThreadMagazineIndex()];
+		{
+			std::scoped_lock magazineLock(magazine.mutex);
+			if (magazine.blocks.size() < MAGAZINE_CAPACITY)
+			{
+				// The block being freed is on its way out, so keep a new view of the same slot in its place.
+				MemoryBlock view = address.GetMemoryPool()->AllocateView(*address.GetOwner(), address.Offset(), address.Size(), address.Handle());
+				view.Reassign(*this);
+				magazine.blocks.emplace_back(std::move(view));
+				return;
+			}
+		}
+
+		std::scoped_lock shardLock(mShard.mutex);
+		address.GetOwner()->Free(std::move(address));
+	}
+
+
+	template<std::derived_from<MonoAllocator> Base>
+	void ConcurrentPolyAllocator<Base>::SlotCache::Flush() noexcept
+	{
+		for (Magazine& magazine : mMagazines)
+		{
+			std::vector<MemoryBlock> blocks;
+			{
+				std::scoped_lock magazineLock(magazine.mutex);
+				std::swap(blocks, magazine.blocks);
+			}
+
+			std::scoped_lock shardLock(mShard.mutex);
+			for (MemoryBlock& block : blocks)
+			{
+				// Destroying the block returns it to its owner.
+				block.Reassign(*block.GetOwner());
+			}
+			blocks.clear();
+		}
+	}
+}
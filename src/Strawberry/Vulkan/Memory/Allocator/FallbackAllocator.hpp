@@ -1,6 +1,4 @@
 #pragma once
-#include <unordered_set>
-
 #include "Strawberry/Vulkan/Memory/Allocator/Allocator.hpp"
 #include "Strawberry/Vulkan/Memory/Allocator/NaiveAllocator.hpp"
 #include "Strawberry/Vulkan/Memory/Allocator/ChainAllocator.hpp"
@@ -21,34 +19,31 @@ namespace Strawberry::Vulkan
 
 		void Free(MemoryBlock&& allocation) noexcept override
 		{
-			if (mFallbackAllocations.contains(allocation.Address()))
-			{
-				mFallbackAllocations.erase(allocation.Address());
-				mFallbackAllocator.Free(std::move(allocation));
-			}
-			else
-			{
-				mMainAllocator.Free(std::move(allocation));
-			}
+			// Blocks point straight at the allocator which produced them, whether that is the fallback or a leaf
+			// allocator inside the main allocator.
+			Core::Assert(allocation.GetAllocator().Get() != this);
+			allocation.GetAllocator()->Free(std::move(allocation));
 		}
 
 
 		AllocationResult Allocate(const AllocationRequest& allocationRequest) noexcept override
 		{
+			// Resources which the driver wants to have memory of their own skip the main allocator entirely.
+			if (allocationRequest.IsDedicated())
+			{
+				return mFallbackAllocator.Allocate(allocationRequest);
+			}
+
 			AllocationResult result = mMainAllocator.Allocate(allocationRequest);
 			if (!result)
 			{
 				const bool allocateFromFallback = result.Err().IsAnyOf<
 					AllocationError::InsufficientPoolSize,
+					AllocationError::RequiresDedicatedAllocation,
 					AllocationError::OutOfMemory>();
 				if (allocateFromFallback)
 				{
-					result = mFallbackAllocator.Allocate(allocationRequest);
-					if (result)
-					{
-						mFallbackAllocations.emplace(result.Value().Address());
-					}
-					return result;
+					return mFallbackAllocator.Allocate(allocationRequest);
 				}
 			}
 
@@ -56,10 +51,29 @@ namespace Strawberry::Vulkan
 			return result;
 		}
 
+
+		// Forwards frame advancement and trimming to the main allocator. Dedicated fallback allocations are already
+		// freed as soon as they are released.
+		void NextFrame() noexcept { mMainAllocator.NextFrame(); }
+		void Trim() noexcept { mMainAllocator.Trim(); }
+
+
+		void VisitPools(const PoolVisitor& visitor) const override
+		{
+			mMainAllocator.VisitPools(visitor);
+			mFallbackAllocator.VisitPools(visitor);
+		}
+
+
+		// Returns the number of device memory allocations held by both the main and fallback allocators.
+		size_t PoolCount() const noexcept
+		{
+			return mMainAllocator.PoolCount() + mFallbackAllocator.PoolCount();
+		}
+
 	private:
-		T                           mMainAllocator;
-		NaiveAllocator              mFallbackAllocator;
-		std::unordered_set<Address> mFallbackAllocations;
+		T              mMainAllocator;
+		NaiveAllocator mFallbackAllocator;
 	};
 
 
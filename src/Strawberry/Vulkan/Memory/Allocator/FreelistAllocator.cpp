@@ -15,6 +15,11 @@ namespace Strawberry::Vulkan
 
 	AllocationResult FreeListAllocator::Allocate(const AllocationRequest& allocationRequest) noexcept
 	{
+		if (allocationRequest.requiresDedicated) [[unlikely]]
+		{
+			return AllocationError::RequiresDedicatedAllocation{};
+		}
+
 		if (Memory().Size() < allocationRequest.size) [[unlikely]]
 		{
 			return AllocationError::InsufficientPoolSize{};
@@ -22,25 +27,50 @@ namespace Strawberry::Vulkan
 
 		// Make sure that this is one of the valid memory types for this allocation.
 		Core::Assert(allocationRequest.typeMask & (1 << Memory().GetMemoryTypeIndex().memoryTypeIndex));
-		// Function for calculating the next aligned address at a position.
-		auto AlignedAddress = [](uintptr_t offset, size_t size, size_t alignment) -> Core::Optional<uintptr_t>
-		{
-			uintptr_t offsetDifference;
-			uintptr_t modulo = offset % alignment;
-			if (modulo == 0) offsetDifference = 0;
-			else offsetDifference             = alignment - modulo;
-			if (offset + offsetDifference >= size) return Core::NullOpt;
-			return offset + offsetDifference;
+		const ResourceKind kind        = allocationRequest.resourceKind;
+		const bool         mayConflict = MayConflict(kind);
+		const size_t       granularity = BufferImageGranularity();
+		const size_t       alignment   = std::max<size_t>(allocationRequest.alignment, 1);
+		// Function for calculating the address an allocation would be placed at within a region.
+		// Returns nothing if the allocation would not fit in the region once aligned, and kept off the
+		// bufferImageGranularity pages of any conflicting neighbours.
+		auto AlignedAddress = [&](const FreeRegion& region) -> Core::Optional<uintptr_t>
+		{
+			uintptr_t address = (region.offset + alignment - 1) / alignment * alignment;
+			if (mayConflict)
+			{
+				// Only the nearest allocations on either side of the region can share a page with it.
+				auto next = mAllocations.lower_bound(region.offset);
+				if (next != mAllocations.begin())
+				{
+					const auto& [prevOffset, prev] = *std::prev(next);
+					if (ResourceKindsConflict(prev.kind, kind)
+						&& (prevOffset + prev.size - 1) / granularity == address / granularity)
+					{
+						const size_t pageAlignment = std::max(alignment, granularity);
+						address = (address + pageAlignment - 1) / pageAlignment * pageAlignment;
+					}
+				}
+
+				if (next != mAllocations.end() && ResourceKindsConflict(next->second.kind, kind)
+					&& (address + allocationRequest.size - 1) / granularity == next->first / granularity)
+				{
+					return Core::NullOpt;
+				}
+			}
+
+			if (address + allocationRequest.size > region.offset + region.size) return Core::NullOpt;
+			return address;
 		};
 
 		// Find a suitable region.
+		Core::Optional<uintptr_t>  alignedAddress;
 		Core::Optional<FreeRegion> region = [&]()-> Core::Optional<FreeRegion>
 		{
 			for (auto [offset, region] : mRegions)
 			{
-				if (Core::Optional<uintptr_t> alignedAddress = AlignedAddress(region.offset,
-				                                                                 region.size,
-				                                                                 allocationRequest.alignment))
+				alignedAddress = AlignedAddress(region);
+				if (alignedAddress)
 				{
 					return RemoveRegion(offset);
 				}
@@ -55,10 +85,16 @@ namespace Strawberry::Vulkan
 			return AllocationError::OutOfMemory();
 		}
 
-		uintptr_t alignedAddress = AlignedAddress(region->offset, region->size, allocationRequest.alignment).Unwrap();
-		uintptr_t alignmentDifference = alignedAddress - region->offset;
+		uintptr_t alignmentDifference = alignedAddress.Value() - region->offset;
 		// Create allocation in the segment of the region.
-		MemoryBlock result = Memory().AllocateView(*this, alignedAddress, allocationRequest.size);
+		MemoryBlock result = Memory().AllocateView(*this, alignedAddress.Value(), allocationRequest.size);
+
+		// Neighbours only need to be tracked when resources might have to be kept apart.
+		if (granularity > 1)
+		{
+			mAllocations.emplace(alignedAddress.Value(), Allocation{.size = allocationRequest.size, .kind = kind});
+		}
+		NoteResourceKind(kind);
 
 		// Track skipped padding
 		const FreeRegion priorRegion{.offset = region->offset, .size = alignmentDifference};
@@ -85,11 +121,59 @@ namespace Strawberry::Vulkan
 
 	void FreeListAllocator::Free(MemoryBlock&& address) noexcept
 	{
+		if (BufferImageGranularity() > 1)
+		{
+			mAllocations.erase(address.Offset());
+		}
+
 		AddFreeRegion(FreeRegion{.offset = address.Offset(), .size = address.Size()});
 		ExpandBlock(address.Offset());
 	}
 
 
+	void FreeListAllocator::VisitFreeRegions(const FreeRegionVisitor& visitor) const
+	{
+		for (const auto& [offset, region] : mRegions)
+		{
+			visitor(region.offset, region.size);
+		}
+	}
+
+
+	size_t FreeListAllocator::FreeBytes() const noexcept
+	{
+		size_t freeBytes = 0;
+		for (const auto& [offset, region] : mRegions)
+		{
+			freeBytes += region.size;
+		}
+		return freeBytes;
+	}
+
+
+	size_t FreeListAllocator::LargestFreeRegion() const noexcept
+	{
+		size_t largest = 0;
+		for (const auto& [offset, region] : mRegions)
+		{
+			largest = std::max(largest, region.size);
+		}
+		return largest;
+	}
+
+
+	double FreeListAllocator::Fragmentation() const noexcept
+	{
+		const size_t freeBytes = FreeBytes();
+		if (freeBytes == 0)
+		{
+			return 0.0;
+		}
+
+		return 1.0 - static_cast<double>(LargestFreeRegion()) / static_cast<double>(freeBytes);
+	}
+
+
 	void FreeListAllocator::AddFreeRegion(FreeRegion region)
 	{
 		// Insert region into list
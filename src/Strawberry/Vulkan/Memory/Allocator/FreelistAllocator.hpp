@@ -25,6 +25,19 @@ namespace Strawberry::Vulkan
 
 		void Free(MemoryBlock&& address) noexcept override;
 
+		void VisitFreeRegions(const FreeRegionVisitor& visitor) const override;
+
+
+		// Returns the total size of all free regions.
+		size_t FreeBytes() const noexcept;
+
+		// Returns the size of the largest free region.
+		size_t LargestFreeRegion() const noexcept;
+
+		// Returns how much of the free space is unusable for a single allocation of all of it, from 0 when the free
+		// space is one contiguous region, approaching 1 as it is scattered into many small regions.
+		double Fragmentation() const noexcept;
+
 	private:
 		struct FreeRegion
 		{
@@ -33,12 +46,22 @@ namespace Strawberry::Vulkan
 		};
 
 
+		struct Allocation
+		{
+			size_t       size;
+			ResourceKind kind;
+		};
+
+
 		using Offset = uint64_t;
 
 		// The container of all the regions of free memory
 		std::map<Offset, FreeRegion> mRegions;
 		// Associates the 
 		std::list<Offset> mRegionsBySize;
+		// The live allocations, used to find the neighbours of free regions when the device has a
+		// bufferImageGranularity greater than 1.
+		std::map<Offset, Allocation> mAllocations;
 
 
 		// Functions for managing the list of regions.
@@ -0,0 +1,79 @@
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+#include "LinearAllocator.hpp"
+#include "Strawberry/Vulkan/Synchronisation/Fence.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+// Standard Library
+#include <algorithm>
+
+
+//======================================================================================================================
+//  Method Definitions
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	LinearAllocator::LinearAllocator(MemoryPool&& memoryPool)
+		: PoolAllocator(std::move(memoryPool))
+	{}
+
+
+	AllocationResult LinearAllocator::Allocate(const AllocationRequest& allocationRequest) noexcept
+	{
+		if (allocationRequest.requiresDedicated) [[unlikely]]
+		{
+			return AllocationError::RequiresDedicatedAllocation{};
+		}
+
+		if (Memory().Size() < allocationRequest.size) [[unlikely]]
+		{
+			return AllocationError::InsufficientPoolSize{};
+		}
+
+		// Make sure that this is one of the valid memory types for this allocation.
+		Core::Assert(allocationRequest.typeMask & (1 << Memory().GetMemoryTypeIndex().memoryTypeIndex));
+
+		// Start on a fresh bufferImageGranularity page if the previous allocation was of a conflicting kind.
+		const size_t granularity = BufferImageGranularity();
+		size_t       alignment   = std::max<size_t>(allocationRequest.alignment, 1);
+		if (mOffset > 0 && granularity > 1 && ResourceKindsConflict(mLastKind, allocationRequest.resourceKind))
+		{
+			alignment = std::max(alignment, granularity);
+		}
+		const size_t offset = (mOffset + alignment - 1) / alignment * alignment;
+		if (offset + allocationRequest.size > Memory().Size())
+		{
+			return AllocationError::OutOfMemory();
+		}
+
+		mOffset   = offset + allocationRequest.size;
+		mLastKind = allocationRequest.resourceKind;
+		return Memory().AllocateView(*this, offset, allocationRequest.size);
+	}
+
+
+	void LinearAllocator::Free(MemoryBlock&& address) noexcept {}
+
+
+	void LinearAllocator::VisitFreeRegions(const FreeRegionVisitor& visitor) const
+	{
+		if (mOffset < Memory().Size())
+		{
+			visitor(mOffset, Memory().Size() - mOffset);
+		}
+	}
+
+
+	void LinearAllocator::Reset() noexcept
+	{
+		mOffset = 0;
+	}
+
+
+	void LinearAllocator::Reset(Fence& frameFence)
+	{
+		frameFence.Wait();
+		Reset();
+	}
+}
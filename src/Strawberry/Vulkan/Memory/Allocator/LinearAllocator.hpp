@@ -0,0 +1,54 @@
+#pragma once
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+// Strawberry Vulkan
+#include "Strawberry/Vulkan/Memory/Allocator/PoolAllocator.hpp"
+
+
+//======================================================================================================================
+//  Class Declaration
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	class Fence;
+
+
+	// Bump allocator for transient per-frame data.
+	//
+	// Allocations are carved from the front of the pool by advancing an offset. Individual blocks are never returned;
+	// instead the whole pool is recycled at once by Reset() after the GPU has finished with everything in it.
+	// An allocation only skips ahead to a new bufferImageGranularity page when it follows one of a conflicting kind.
+	class LinearAllocator
+			: public PoolAllocator
+	{
+	public:
+		LinearAllocator(MemoryPool&& memoryPool);
+
+
+		AllocationResult Allocate(const AllocationRequest& allocationRequest) noexcept override;
+
+		// Does nothing. Memory is only reclaimed by Reset().
+		void Free(MemoryBlock&& address) noexcept override;
+
+		// Visits the space after the last allocation.
+		void VisitFreeRegions(const FreeRegionVisitor& visitor) const override;
+
+
+		// Releases every allocation made from this allocator.
+		// The caller must ensure that the GPU is no longer using any of them.
+		void Reset() noexcept;
+
+		// Waits for the given fence, which should guard the last use of this allocator's memory, and then resets.
+		void Reset(Fence& frameFence);
+
+
+		// Returns the number of bytes handed out since the last reset, including alignment padding.
+		[[nodiscard]] size_t BytesUsed() const noexcept { return mOffset; }
+
+	private:
+		size_t       mOffset   = 0;
+		// The kind of resource most recently allocated, which is the only one that the next allocation can neighbour.
+		ResourceKind mLastKind = ResourceKind::Unknown;
+	};
+}
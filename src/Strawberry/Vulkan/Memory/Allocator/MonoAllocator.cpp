@@ -8,8 +8,24 @@ namespace Strawberry::Vulkan
 		  , mMemoryTypeIndex(memoryTypeIndex) {}
 
 
+	MonoAllocator::MonoAllocator(Device* device, MemoryTypeIndex memoryTypeIndex)
+		: Allocator(device)
+		  , mMemoryTypeIndex(memoryTypeIndex) {}
+
+
 	const MemoryTypeIndex MonoAllocator::GetMemoryTypeIndex() const noexcept
 	{
 		return mMemoryTypeIndex;
 	}
+
+
+	MemoryUsage MonoAllocator::GetUsage() const
+	{
+		MemoryUsage usage;
+		VisitPools([&](const MemoryPool& pool, const PoolAllocator* allocator)
+		{
+			usage += MemoryUsage::Of(pool, allocator);
+		});
+		return usage;
+	}
 }
@@ -4,6 +4,7 @@
 #include "Strawberry/Core/Types/Result.hpp"
 #include "Strawberry/Vulkan/Memory/Allocator/Allocator.hpp"
 #include "Strawberry/Vulkan/Memory/Allocator/AllocationRequest.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/AllocatorStatistics.hpp"
 
 
 namespace Strawberry::Vulkan
@@ -16,12 +17,20 @@ namespace Strawberry::Vulkan
 	{
 	public:
 		MonoAllocator(Device& device, MemoryTypeIndex memoryTypeIndex);
+		MonoAllocator(Device* device, MemoryTypeIndex memoryTypeIndex);
 
 		virtual AllocationResult Allocate(const AllocationRequest& allocationRequest) noexcept = 0;
 
 
 		const MemoryTypeIndex GetMemoryTypeIndex() const noexcept;
 
+
+		// Calls the given function with every device memory allocation this allocator currently holds.
+		virtual void VisitPools(const PoolVisitor& visitor) const = 0;
+
+		// Returns the combined usage of every device memory allocation this allocator currently holds.
+		MemoryUsage GetUsage() const;
+
 	private:
 		MemoryTypeIndex mMemoryTypeIndex;
 	};
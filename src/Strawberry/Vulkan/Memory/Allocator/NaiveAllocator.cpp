@@ -10,7 +10,20 @@ namespace Strawberry::Vulkan
 
 	AllocationResult NaiveAllocator::Allocate(const AllocationRequest& allocationRequest) noexcept
 	{
-		MemoryPool memoryPool = MemoryPool::Allocate(GetDevice(), GetMemoryTypeIndex(), allocationRequest.size).Unwrap();
+		auto memoryPoolResult = allocationRequest.IsDedicated()
+			? MemoryPool::AllocateDedicated(
+				GetDevice(),
+				GetMemoryTypeIndex(),
+				allocationRequest.size,
+				allocationRequest.dedicatedBuffer,
+				allocationRequest.dedicatedImage,
+				allocationRequest.priority)
+			: MemoryPool::Allocate(GetDevice(), GetMemoryTypeIndex(), allocationRequest.size);
+		if (!memoryPoolResult)
+		{
+			return AllocationError::OutOfMemory();
+		}
+		MemoryPool memoryPool = memoryPoolResult.Unwrap();
 
 		MemoryBlock allocation = memoryPool.AllocateView(*this, 0, memoryPool.Size());
 		mMemoryPools.emplace(allocation.Address(), std::move(memoryPool));
@@ -21,4 +34,19 @@ namespace Strawberry::Vulkan
 	{
 		mMemoryPools.erase(address.Address());
 	}
+
+
+	void NaiveAllocator::VisitPools(const PoolVisitor& visitor) const
+	{
+		for (const auto& [address, memoryPool] : mMemoryPools)
+		{
+			visitor(memoryPool, nullptr);
+		}
+	}
+
+
+	size_t NaiveAllocator::PoolCount() const noexcept
+	{
+		return mMemoryPools.size();
+	}
 }
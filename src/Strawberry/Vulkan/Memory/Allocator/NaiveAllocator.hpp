@@ -13,6 +13,14 @@ namespace Strawberry::Vulkan
 		AllocationResult Allocate(const AllocationRequest& allocationRequest) noexcept override;
 		void             Free(MemoryBlock&& address) noexcept override;
 
+
+		// Every pool is handed out whole, so none are visited with an allocator.
+		void VisitPools(const PoolVisitor& visitor) const override;
+
+
+		// Returns the number of device memory allocations currently held.
+		size_t PoolCount() const noexcept;
+
 	private:
 		std::unordered_map<Address, MemoryPool> mMemoryPools;
 	};
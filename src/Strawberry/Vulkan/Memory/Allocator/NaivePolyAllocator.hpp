@@ -1,7 +1,13 @@
 #pragma once
+#include "Strawberry/Vulkan/Memory/Allocator/ChainAllocator.hpp"
 #include "Strawberry/Vulkan/Memory/Allocator/MonoAllocator.hpp"
 #include "Strawberry/Vulkan/Memory/Allocator/PolyAllocator.hpp"
-#include <unordered_set>
+#include "Strawberry/Vulkan/Memory/Allocator/SlabAllocator.hpp"
+// Standard Library
+#include <algorithm>
+#include <array>
+#include <map>
+#include <span>
 
 
 namespace Strawberry::Vulkan
@@ -11,6 +17,11 @@ namespace Strawberry::Vulkan
 			: public PolyAllocator
 	{
 	public:
+		// The size of each memory pool requested from the device for small allocations.
+		// Pools for everything else are sized from their heap, see ChainGrowthPolicy::ForHeap.
+		static constexpr size_t SMALL_POOL_SIZE = 4 * 1024 * 1024;
+
+
 		explicit NaivePolyAllocator(Device& device)
 			: PolyAllocator(device) {}
 
@@ -18,16 +29,32 @@ namespace Strawberry::Vulkan
 
 		MonoAllocator& GetAllocator(MemoryTypeIndex typeIndex);
 
+		// Returns the allocator for small requests of the given memory type.
+		MonoAllocator& GetSmallAllocator(MemoryTypeIndex typeIndex);
+
 		AllocationResult Allocate(const AllocationRequest&  allocationResult,
 								  const MemoryTypeCriteria& memoryTypeCriteria) noexcept override;
 
 		void Free(MemoryBlock&& address) noexcept override;
 
+
+		void NextFrame() noexcept override;
+
+		void Trim() noexcept override;
+
+
+		void VisitPools(const PoolVisitor& visitor) const override;
+
 	private:
+		// Allocates from the given memory type, preferring slabs for small requests.
+		AllocationResult AllocateFromType(MemoryTypeIndex typeIndex, const AllocationRequest& allocationRequest) noexcept;
+
+
 		struct BaseAllocator
 		{
-			Base                        allocator;
-			std::unordered_set<Address> mAllocatedAddresses;
+			Base                                          allocator;
+			// Serves requests small enough for SlabAllocator. Created the first time one is made of this memory type.
+			Core::Optional<ChainAllocator<SlabAllocator>> smallAllocator;
 		};
 
 		std::map<MemoryTypeIndex, BaseAllocator> mAllocators;
@@ -39,43 +66,109 @@ namespace Strawberry::Vulkan
 	{
 		if (!mAllocators.contains(typeIndex)) [[unlikely]]
 		{
-			mAllocators.emplace(typeIndex, Base{ { GetDevice(), typeIndex, size_t{ 4 * 1024 * 1024 } } });
+			const auto& memoryProperties = GetDevice().GetPhysicalDevice().GetMemoryProperties();
+			const auto  heapIndex        = memoryProperties.memoryTypes[typeIndex.memoryTypeIndex].heapIndex;
+			const auto  growthPolicy     = ChainGrowthPolicy::ForHeap(memoryProperties.memoryHeaps[heapIndex].size);
+			mAllocators.emplace(typeIndex, Base{ { GetDevice(), typeIndex, growthPolicy } });
 		}
 
 		return mAllocators.at(typeIndex).allocator;
 	}
 
+	template<std::derived_from<MonoAllocator> Base>
+	MonoAllocator& NaivePolyAllocator<Base>::GetSmallAllocator(MemoryTypeIndex typeIndex)
+	{
+		GetAllocator(typeIndex);
+
+		auto& smallAllocator = mAllocators.at(typeIndex).smallAllocator;
+		if (!smallAllocator) [[unlikely]]
+		{
+			smallAllocator.Emplace(GetDevice(), typeIndex, SMALL_POOL_SIZE);
+		}
+
+		return smallAllocator.Value();
+	}
+
 	template<std::derived_from<MonoAllocator> Base>
 	AllocationResult NaivePolyAllocator<Base>::Allocate(
 		const AllocationRequest&  allocationResult,
 		const MemoryTypeCriteria& memoryTypeCriteria) noexcept
 	{
-		auto candidateMemoryTypes =
-				GetDevice().GetPhysicalDevice().SearchMemoryTypes(memoryTypeCriteria);
-
-		auto selectedMemoryType = candidateMemoryTypes[0];
+		const MemoryTypeOrder order = GetMemoryTypeOrder(allocationResult, memoryTypeCriteria);
+		if (order.count == 0) [[unlikely]]
+		{
+			return AllocationError::OutOfMemory();
+		}
 
-		auto result = GetAllocator(selectedMemoryType.index).Allocate(allocationResult);
-		if (result)
+		for (size_t i = 0; i + 1 < order.count; i++)
 		{
-			mAllocators.at(selectedMemoryType.index).mAllocatedAddresses.emplace(result.Value().Address());
+			if (auto result = AllocateFromType(order.types[i], allocationResult))
+			{
+				return result;
+			}
+
+			// Something failed, so our view of the heaps is probably out of date.
+			InvalidateHeapBudgets();
 		}
 
-		return result;
+		return AllocateFromType(order.types[order.count - 1], allocationResult);
 	}
 
 	template<std::derived_from<MonoAllocator> Base>
-	void NaivePolyAllocator<Base>::Free(MemoryBlock&& address) noexcept
+	AllocationResult NaivePolyAllocator<Base>::AllocateFromType(
+		MemoryTypeIndex          typeIndex,
+		const AllocationRequest& allocationRequest) noexcept
 	{
-		for (auto& allocator: mAllocators)
+		// Route small requests to slabs, falling back on the general allocator if they cannot be served there.
+		if (SlabAllocator::IsSmallAllocation(allocationRequest) && !allocationRequest.IsDedicated())
 		{
-			if (allocator.second.mAllocatedAddresses.contains(address.Address()))
+			auto result = GetSmallAllocator(typeIndex).Allocate(allocationRequest);
+			if (result)
 			{
-				allocator.second.allocator.Free(std::move(address));
-				break;
+				return result;
 			}
 		}
 
-		Core::Unreachable();
+		return GetAllocator(typeIndex).Allocate(allocationRequest);
+	}
+
+	template<std::derived_from<MonoAllocator> Base>
+	void NaivePolyAllocator<Base>::Free(MemoryBlock&& address) noexcept
+	{
+		// Blocks point straight at the leaf allocator which produced them.
+		Core::Assert(address.GetAllocator().Get() != this);
+		address.GetAllocator()->Free(std::move(address));
+	}
+
+	template<std::derived_from<MonoAllocator> Base>
+	void NaivePolyAllocator<Base>::NextFrame() noexcept
+	{
+		for (auto& [typeIndex, baseAllocator] : mAllocators)
+		{
+			baseAllocator.allocator.NextFrame();
+			if (baseAllocator.smallAllocator) baseAllocator.smallAllocator->NextFrame();
+		}
+
+		SamplePeaks();
+	}
+
+	template<std::derived_from<MonoAllocator> Base>
+	void NaivePolyAllocator<Base>::Trim() noexcept
+	{
+		for (auto& [typeIndex, baseAllocator] : mAllocators)
+		{
+			baseAllocator.allocator.Trim();
+			if (baseAllocator.smallAllocator) baseAllocator.smallAllocator->Trim();
+		}
+	}
+
+	template<std::derived_from<MonoAllocator> Base>
+	void NaivePolyAllocator<Base>::VisitPools(const PoolVisitor& visitor) const
+	{
+		for (const auto& [typeIndex, baseAllocator] : mAllocators)
+		{
+			baseAllocator.allocator.VisitPools(visitor);
+			if (baseAllocator.smallAllocator) baseAllocator.smallAllocator->VisitPools(visitor);
+		}
 	}
 }
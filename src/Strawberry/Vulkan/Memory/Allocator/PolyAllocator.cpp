@@ -0,0 +1,283 @@
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+#include "PolyAllocator.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/PoolAllocator.hpp"
+// Standard Library
+#include <sstream>
+
+
+//======================================================================================================================
+//  Method Definitions
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	static void WriteUsage(std::ostream& stream, const MemoryUsage& usage)
+	{
+		stream << "{"
+			<< "\"deviceAllocationCount\":" << usage.deviceAllocationCount
+			<< ",\"reservedBytes\":" << usage.reservedBytes
+			<< ",\"blockCount\":" << usage.blockCount
+			<< ",\"usedBytes\":" << usage.usedBytes
+			<< ",\"freeRegionCount\":" << usage.freeRegionCount
+			<< ",\"freeBytes\":" << usage.freeBytes
+			<< ",\"largestFreeRegion\":" << usage.largestFreeRegion
+			<< ",\"fragmentation\":" << usage.Fragmentation()
+			<< "}";
+	}
+
+
+	static void WritePeaks(std::ostream& stream, const MemoryPeaks& peaks)
+	{
+		stream << "{"
+			<< "\"deviceAllocationCount\":" << peaks.deviceAllocationCount
+			<< ",\"reservedBytes\":" << peaks.reservedBytes
+			<< ",\"usedBytes\":" << peaks.usedBytes
+			<< "}";
+	}
+
+
+	static void WriteRegion(std::ostream& stream, bool& first, size_t offset, size_t size, bool free)
+	{
+		stream << (first ? "" : ",")
+			<< "{\"offset\":" << offset << ",\"size\":" << size << ",\"free\":" << (free ? "true" : "false") << "}";
+		first = false;
+	}
+
+
+	// Writes a pool along with its block map. Everything between the free regions is reported as used, including
+	// any alignment padding.
+	static void WritePool(std::ostream& stream, const MemoryPool& pool, const PoolAllocator* allocator)
+	{
+		stream << "{\"usage\":";
+		WriteUsage(stream, MemoryUsage::Of(pool, allocator));
+		stream << ",\"blocks\":[";
+
+		bool first = true;
+		if (allocator)
+		{
+			size_t end = 0;
+			allocator->VisitFreeRegions([&](size_t offset, size_t size)
+			{
+				if (offset > end) WriteRegion(stream, first, end, offset - end, false);
+				WriteRegion(stream, first, offset, size, true);
+				end = offset + size;
+			});
+			if (end < pool.Size()) WriteRegion(stream, first, end, pool.Size() - end, false);
+		}
+		else if (!pool.IsEmpty())
+		{
+			WriteRegion(stream, first, 0, pool.Size(), false);
+		}
+
+		stream << "]}";
+	}
+
+
+	MemoryStatistics PolyAllocator::GetStatistics() const
+	{
+		MemoryStatistics statistics = GatherStatistics(true);
+		UpdatePeaks(statistics);
+		return statistics;
+	}
+
+
+	void PolyAllocator::WriteStatisticsJson(std::ostream& stream) const
+	{
+		const auto& memoryProperties = GetDevice().GetPhysicalDevice().GetMemoryProperties();
+
+		// Pools may only be looked at whilst they are being visited, so their block maps are written out straight away,
+		// and the statistics are gathered in the same pass so that they agree with them.
+		MemoryStatistics statistics;
+		statistics.maxMemoryAllocationCount = GetDevice().GetPhysicalDevice().GetLimits().maxMemoryAllocationCount;
+		std::array<std::ostringstream, VK_MAX_MEMORY_TYPES> pools;
+		VisitPools([&](const MemoryPool& pool, const PoolAllocator* allocator)
+		{
+			const uint32_t typeIndex = pool.GetMemoryTypeIndex().memoryTypeIndex;
+			AddPoolUsage(statistics, pool, allocator);
+			pools[typeIndex] << (statistics.types[typeIndex].deviceAllocationCount > 1 ? "," : "");
+			WritePool(pools[typeIndex], pool, allocator);
+		});
+		UpdatePeaks(statistics);
+
+		stream << "{\"maxMemoryAllocationCount\":" << statistics.maxMemoryAllocationCount << ",\"total\":";
+		WriteUsage(stream, statistics.total);
+		stream << ",\"totalPeaks\":";
+		WritePeaks(stream, statistics.totalPeaks);
+
+		stream << ",\"heaps\":[";
+		for (uint32_t heap = 0; heap < memoryProperties.memoryHeapCount; heap++)
+		{
+			stream << (heap == 0 ? "" : ",")
+				<< "{\"index\":" << heap << ",\"size\":" << memoryProperties.memoryHeaps[heap].size << ",\"usage\":";
+			WriteUsage(stream, statistics.heaps[heap]);
+			stream << ",\"peaks\":";
+			WritePeaks(stream, statistics.heapPeaks[heap]);
+			stream << "}";
+		}
+
+		stream << "],\"types\":[";
+		bool firstType = true;
+		for (uint32_t type = 0; type < memoryProperties.memoryTypeCount; type++)
+		{
+			if (statistics.types[type].deviceAllocationCount == 0) continue;
+
+			stream << (firstType ? "" : ",")
+				<< "{\"index\":" << type
+				<< ",\"heapIndex\":" << memoryProperties.memoryTypes[type].heapIndex
+				<< ",\"propertyFlags\":" << memoryProperties.memoryTypes[type].propertyFlags
+				<< ",\"usage\":";
+			WriteUsage(stream, statistics.types[type]);
+			stream << ",\"pools\":[" << pools[type].str() << "]}";
+			firstType = false;
+		}
+		stream << "]}";
+	}
+
+
+	PolyAllocator::MemoryTypeOrder PolyAllocator::GetMemoryTypeOrder(
+		const AllocationRequest&  allocationRequest,
+		const MemoryTypeCriteria& memoryTypeCriteria)
+	{
+		const CandidateMemoryTypes& candidates = GetCandidateMemoryTypes(memoryTypeCriteria, allocationRequest.typeMask);
+
+		// Take the best ranked types whose heaps still have room first, and only then those which are close to their budget.
+		UpdateHeapBudgets();
+		MemoryTypeOrder order;
+		for (const MemoryType& type : candidates.Span())
+		{
+			if (!IsNearBudget(type, allocationRequest.size)) order.types[order.count++] = type.index;
+		}
+		for (const MemoryType& type : candidates.Span())
+		{
+			if (IsNearBudget(type, allocationRequest.size)) order.types[order.count++] = type.index;
+		}
+
+		return order;
+	}
+
+
+	void PolyAllocator::InvalidateHeapBudgets() noexcept
+	{
+		mAllocationsUntilBudgetUpdate.store(0, std::memory_order_relaxed);
+	}
+
+
+	void PolyAllocator::SetPeakTracking(bool enabled) noexcept
+	{
+		mPeakTracking.store(enabled, std::memory_order_relaxed);
+	}
+
+
+	void PolyAllocator::SamplePeaks() const
+	{
+		if (!mPeakTracking.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		MemoryStatistics statistics = GatherStatistics(false);
+		UpdatePeaks(statistics);
+	}
+
+
+	const PolyAllocator::CandidateMemoryTypes& PolyAllocator::GetCandidateMemoryTypes(
+		const MemoryTypeCriteria& memoryTypeCriteria,
+		uint32_t                  typeMask)
+	{
+		const CandidateKey key{
+			.minimumSize = memoryTypeCriteria.minimumSize,
+			.requiredProperties = memoryTypeCriteria.requiredProperties,
+			.preferredProperties = memoryTypeCriteria.preferredProperties,
+			.typeMask = typeMask
+		};
+
+		{
+			std::shared_lock lock(mCandidateMutex);
+			if (auto search = mCandidateMemoryTypes.find(key); search != mCandidateMemoryTypes.end()) [[likely]]
+			{
+				return search->second;
+			}
+		}
+
+		CandidateMemoryTypes candidates;
+		for (const MemoryType& type : GetDevice().GetPhysicalDevice().SearchMemoryTypes(memoryTypeCriteria))
+		{
+			if (typeMask & (1 << type.index.memoryTypeIndex))
+			{
+				candidates.types[candidates.count++] = type;
+			}
+		}
+
+		// Another thread may have got here first, in which case its identical result is kept.
+		std::unique_lock lock(mCandidateMutex);
+		return mCandidateMemoryTypes.emplace(key, candidates).first->second;
+	}
+
+
+	void PolyAllocator::UpdateHeapBudgets() noexcept
+	{
+		if (mAllocationsUntilBudgetUpdate.fetch_sub(1, std::memory_order_relaxed) <= 0)
+		{
+			mAllocationsUntilBudgetUpdate.store(BUDGET_UPDATE_INTERVAL, std::memory_order_relaxed);
+
+			const auto budgets = GetDevice().GetPhysicalDevice().GetMemoryBudget();
+			for (size_t heap = 0; heap < budgets.size(); heap++)
+			{
+				mHeapBudgets[heap].store(budgets[heap].budget, std::memory_order_relaxed);
+				mHeapUsages[heap].store(budgets[heap].usage, std::memory_order_relaxed);
+			}
+		}
+	}
+
+
+	bool PolyAllocator::IsNearBudget(const MemoryType& type, size_t size) const noexcept
+	{
+		const VkDeviceSize budget = mHeapBudgets[type.heapIndex].load(std::memory_order_relaxed);
+		const VkDeviceSize usage  = mHeapUsages[type.heapIndex].load(std::memory_order_relaxed);
+		return usage + size + budget / BUDGET_MARGIN_DIVISOR > budget;
+	}
+
+
+	MemoryStatistics PolyAllocator::GatherStatistics(bool includeFreeRegions) const
+	{
+		MemoryStatistics statistics;
+		statistics.maxMemoryAllocationCount = GetDevice().GetPhysicalDevice().GetLimits().maxMemoryAllocationCount;
+		VisitPools([&](const MemoryPool& pool, const PoolAllocator* allocator)
+		{
+			AddPoolUsage(statistics, pool, includeFreeRegions ? allocator : nullptr);
+		});
+
+		return statistics;
+	}
+
+
+	void PolyAllocator::AddPoolUsage(MemoryStatistics& statistics, const MemoryPool& pool, const PoolAllocator* allocator) const
+	{
+		const auto&       memoryProperties = GetDevice().GetPhysicalDevice().GetMemoryProperties();
+		const MemoryUsage usage            = MemoryUsage::Of(pool, allocator);
+		const uint32_t    typeIndex        = pool.GetMemoryTypeIndex().memoryTypeIndex;
+		statistics.types[typeIndex]                                          += usage;
+		statistics.heaps[memoryProperties.memoryTypes[typeIndex].heapIndex] += usage;
+		statistics.total                                                     += usage;
+	}
+
+
+	void PolyAllocator::UpdatePeaks(MemoryStatistics& statistics) const
+	{
+		if (!mPeakTracking.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		std::scoped_lock lock(mPeakMutex);
+		for (size_t heap = 0; heap < VK_MAX_MEMORY_HEAPS; heap++)
+		{
+			mHeapPeaks[heap].Update(statistics.heaps[heap]);
+		}
+		mTotalPeaks.Update(statistics.total);
+
+		statistics.heapPeaks  = mHeapPeaks;
+		statistics.totalPeaks = mTotalPeaks;
+	}
+}
@@ -1,4 +1,15 @@
 #pragma once
+#include "Strawberry/Vulkan/Memory/Allocator/AllocatorStatistics.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/MonoAllocator.hpp"
+#include "Strawberry/Vulkan/Memory/Memory.hpp"
+#include <array>
+#include <atomic>
+#include <compare>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <shared_mutex>
+#include <span>
 
 
 namespace Strawberry::Vulkan
@@ -12,5 +23,121 @@ namespace Strawberry::Vulkan
 		~PolyAllocator() override = default;
 
 		virtual AllocationResult Allocate(const AllocationRequest& allocationRequest, const MemoryTypeCriteria& memoryTypeCriteria) noexcept = 0;
+
+
+		// Should be called once per frame, so that memory which has gone unused for a while can be released.
+		virtual void NextFrame() noexcept = 0;
+
+		// Releases all memory which is not currently in use, for when memory is under pressure.
+		virtual void Trim() noexcept = 0;
+
+
+		// Calls the given function with every device memory allocation this allocator currently holds.
+		virtual void VisitPools(const PoolVisitor& visitor) const = 0;
+
+
+		// Gathers the usage of every memory type and heap that this allocator holds memory in. Nothing is counted
+		// as blocks come and go, so this walks every pool, and is meant to be called occasionally rather than per frame.
+		MemoryStatistics GetStatistics() const;
+
+		// Writes GetStatistics() to the given stream as JSON, along with a map of the blocks in every pool.
+		void WriteStatisticsJson(std::ostream& stream) const;
+
+		// Enables or disables recording peak usage, which is sampled every NextFrame() and whenever statistics are
+		// gathered, so spikes within a single frame are missed. Disabled by default, in which case it costs nothing.
+		void SetPeakTracking(bool enabled) noexcept;
+
+
+	protected:
+		// The memory types to try an allocation in, in the order they should be tried.
+		struct MemoryTypeOrder
+		{
+			std::array<MemoryTypeIndex, VK_MAX_MEMORY_TYPES> types;
+			size_t                                           count = 0;
+
+
+			std::span<const MemoryTypeIndex> Span() const noexcept { return {types.data(), count}; }
+		};
+
+
+		// Returns the memory types which satisfy the criteria and the request's type mask, best suited first, except
+		// that those whose heaps would be left close to their budget are put after all of the others. May be called
+		// from many threads at once.
+		MemoryTypeOrder GetMemoryTypeOrder(const AllocationRequest& allocationRequest, const MemoryTypeCriteria& memoryTypeCriteria);
+
+		// Has the next call to GetMemoryTypeOrder() refresh the heap budgets, for when an allocation has failed and they
+		// are probably out of date.
+		void InvalidateHeapBudgets() noexcept;
+
+
+		// Records the current usage in the peaks if peak tracking is enabled. Called at the end of NextFrame().
+		void SamplePeaks() const;
+
+
+	private:
+		// How many allocations are made between refreshing the heap budgets.
+		static constexpr unsigned BUDGET_UPDATE_INTERVAL = 64;
+		// A heap is considered near its limit once less than this fraction of its budget would remain.
+		static constexpr size_t   BUDGET_MARGIN_DIVISOR  = 16;
+
+
+		// The memory types which satisfy some criteria and type mask, best suited first.
+		struct CandidateMemoryTypes
+		{
+			std::array<MemoryType, VK_MAX_MEMORY_TYPES> types;
+			size_t                                      count = 0;
+
+
+			std::span<const MemoryType> Span() const noexcept { return {types.data(), count}; }
+		};
+
+
+		struct CandidateKey
+		{
+			size_t                minimumSize;
+			VkMemoryPropertyFlags requiredProperties;
+			VkMemoryPropertyFlags preferredProperties;
+			uint32_t              typeMask;
+
+
+			std::strong_ordering operator<=>(const CandidateKey&) const noexcept = default;
+		};
+
+
+		// Returns the ranked memory types for the given criteria and type mask, searching for them the first time a
+		// combination is seen.
+		const CandidateMemoryTypes& GetCandidateMemoryTypes(const MemoryTypeCriteria& memoryTypeCriteria, uint32_t typeMask);
+
+		// Refreshes the heap budgets from the device every BUDGET_UPDATE_INTERVAL calls.
+		void UpdateHeapBudgets() noexcept;
+
+		// Whether allocating the given number of bytes from the given type would leave its heap close to its budget.
+		bool IsNearBudget(const MemoryType& type, size_t size) const noexcept;
+
+
+		// Gathers usage per memory type and heap, walking the free regions of each pool only if asked to.
+		MemoryStatistics GatherStatistics(bool includeFreeRegions) const;
+
+		// Adds the usage of the given pool to its memory type, its heap and the total.
+		void AddPoolUsage(MemoryStatistics& statistics, const MemoryPool& pool, const PoolAllocator* allocator) const;
+
+		// Raises the recorded peaks to the usage in the given statistics, and copies them into it.
+		void UpdatePeaks(MemoryStatistics& statistics) const;
+
+
+		std::atomic<bool>                                    mPeakTracking = false;
+		mutable std::mutex                                   mPeakMutex;
+		mutable std::array<MemoryPeaks, VK_MAX_MEMORY_HEAPS> mHeapPeaks{};
+		mutable MemoryPeaks                                  mTotalPeaks;
+
+
+		// Memory type searches are cached, as there are only ever a handful of distinct ones.
+		std::shared_mutex                            mCandidateMutex;
+		std::map<CandidateKey, CandidateMemoryTypes> mCandidateMemoryTypes;
+
+		// A slightly stale view of the budgets is fine, so these are updated without a lock.
+		std::array<std::atomic<VkDeviceSize>, VK_MAX_MEMORY_HEAPS> mHeapBudgets{};
+		std::array<std::atomic<VkDeviceSize>, VK_MAX_MEMORY_HEAPS> mHeapUsages{};
+		std::atomic<int>                                           mAllocationsUntilBudgetUpdate = 0;
 	};
-}
\ No newline at end of file
+}
@@ -4,8 +4,10 @@
 namespace Strawberry::Vulkan
 {
 	PoolAllocator::PoolAllocator(MemoryPool&& memoryPool)
-			: MonoAllocator(memoryPool.GetDevice(), memoryPool.GetMemoryTypeIndex())
+			: MonoAllocator(memoryPool.HasDevice() ? &memoryPool.GetDevice() : nullptr, memoryPool.GetMemoryTypeIndex())
 			, mMemoryPool(std::move(memoryPool))
+			// Pools without a device have nothing to keep resources apart for.
+			, mBufferImageGranularity(mMemoryPool.HasDevice() ? GetDevice().GetPhysicalDevice().GetLimits().bufferImageGranularity : 1)
 	{}
 
 	const MemoryPool& PoolAllocator::Memory() const noexcept
@@ -17,4 +19,15 @@ namespace Strawberry::Vulkan
 	{
 		return mMemoryPool;
 	}
+
+	bool PoolAllocator::MayConflict(ResourceKind kind) const noexcept
+	{
+		if (mBufferImageGranularity <= 1)
+		{
+			return false;
+		}
+
+		const uint8_t kindBit = uint8_t{1} << static_cast<uint8_t>(kind);
+		return kind == ResourceKind::Unknown || (mResourceKinds & ~kindBit) != 0;
+	}
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include "MonoAllocator.hpp"
+#include <cstdint>
 
 
 namespace Strawberry::Vulkan
@@ -15,7 +16,29 @@ namespace Strawberry::Vulkan
 		MemoryPool& Memory() noexcept;
 
 
+		void VisitPools(const PoolVisitor& visitor) const override { visitor(mMemoryPool, this); }
+
+		// Calls the given function with each region of the pool which is not in use, in address order.
+		virtual void VisitFreeRegions(const FreeRegionVisitor& visitor) const = 0;
+
+
+	protected:
+		// The device's bufferImageGranularity. Linear and optimal resources must not share a page of this size.
+		size_t BufferImageGranularity() const noexcept { return mBufferImageGranularity; }
+
+		// Returns whether a resource of the given kind could end up sharing a page with a conflicting neighbour.
+		// This is never the case when the granularity is 1, or when every resource placed in this pool so far has
+		// been of the same known kind, in which case placement needs no extra care.
+		bool MayConflict(ResourceKind kind) const noexcept;
+
+		// Records that a resource of the given kind has been placed in this pool.
+		void NoteResourceKind(ResourceKind kind) noexcept { mResourceKinds |= uint8_t{1} << static_cast<uint8_t>(kind); }
+
+
 	private:
 		MemoryPool mMemoryPool;
+		size_t     mBufferImageGranularity;
+		// Bit n is set once a resource of ResourceKind n has been placed in this pool.
+		uint8_t    mResourceKinds = 0;
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,114 @@
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+#include "RecordingPolyAllocator.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+
+
+//======================================================================================================================
+//  Method Definitions
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	RecordingPolyAllocator::RecordingPolyAllocator(std::unique_ptr<PolyAllocator> allocator, std::unique_ptr<std::ostream> trace)
+		: PolyAllocator(allocator->GetDevice())
+		, mAllocator(std::move(allocator))
+		, mStartTime(std::chrono::steady_clock::now())
+		, mTrace(std::move(trace))
+	{
+		WriteAllocationTraceHeader(*mTrace);
+	}
+
+
+	RecordingPolyAllocator::~RecordingPolyAllocator()
+	{
+		mTrace->flush();
+	}
+
+
+	AllocationResult RecordingPolyAllocator::Allocate(
+		const AllocationRequest&  allocationRequest,
+		const MemoryTypeCriteria& memoryTypeCriteria) noexcept
+	{
+		AllocationTraceRecord record{
+			.timestamp = Now(),
+			.id = 0,
+			.size = allocationRequest.size,
+			.alignment = allocationRequest.alignment,
+			.minimumSize = memoryTypeCriteria.minimumSize,
+			.typeMask = allocationRequest.typeMask,
+			.requiredProperties = memoryTypeCriteria.requiredProperties,
+			.preferredProperties = memoryTypeCriteria.preferredProperties,
+			.resourceKind = static_cast<uint8_t>(allocationRequest.resourceKind),
+			.dedicated = allocationRequest.IsDedicated(),
+			.event = AllocationTraceEvent::Allocate
+		};
+
+		AllocationResult result = mAllocator->Allocate(allocationRequest, memoryTypeCriteria);
+
+		std::scoped_lock lock(mMutex);
+		if (!result)
+		{
+			WriteAllocationTraceRecord(*mTrace, record);
+			return result;
+		}
+
+		MemoryBlock block = result.Unwrap();
+		record.id              = mNextId++;
+		record.offset          = block.Offset();
+		record.succeeded       = true;
+		record.memoryTypeIndex = static_cast<uint8_t>(block.GetMemoryPool()->GetMemoryTypeIndex().memoryTypeIndex);
+		WriteAllocationTraceRecord(*mTrace, record);
+
+		mLiveBlocks.emplace(block.Address(), LiveBlock{.id = record.id, .owner = block.GetAllocator()});
+		block.Reassign(*this);
+		return block;
+	}
+
+
+	void RecordingPolyAllocator::Free(MemoryBlock&& address) noexcept
+	{
+		Core::ReflexivePointer<Allocator> owner = nullptr;
+		{
+			std::scoped_lock lock(mMutex);
+			auto liveBlock = mLiveBlocks.extract(address.Address());
+			Core::Assert(!liveBlock.empty());
+
+			WriteAllocationTraceRecord(*mTrace, AllocationTraceRecord{
+				.timestamp = Now(),
+				.id = liveBlock.mapped().id,
+				.event = AllocationTraceEvent::Free
+			});
+			owner = liveBlock.mapped().owner;
+		}
+
+		address.Reassign(*owner);
+		owner->Free(std::move(address));
+	}
+
+
+	void RecordingPolyAllocator::NextFrame() noexcept
+	{
+		mAllocator->NextFrame();
+		SamplePeaks();
+	}
+
+
+	void RecordingPolyAllocator::Trim() noexcept
+	{
+		mAllocator->Trim();
+	}
+
+
+	void RecordingPolyAllocator::VisitPools(const PoolVisitor& visitor) const
+	{
+		mAllocator->VisitPools(visitor);
+	}
+
+
+	uint64_t RecordingPolyAllocator::Now() const noexcept
+	{
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - mStartTime).count();
+	}
+}
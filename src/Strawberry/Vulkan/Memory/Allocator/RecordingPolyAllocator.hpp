@@ -0,0 +1,73 @@
+#pragma once
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+// Strawberry Vulkan
+#include "Strawberry/Vulkan/Memory/Allocator/PolyAllocator.hpp"
+#include "Strawberry/Vulkan/Memory/AllocationTrace.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Types/ReflexivePointer.hpp"
+// Standard Library
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+
+
+//======================================================================================================================
+//  Class Declaration
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	// Records every allocation and free made through another allocator to an allocation trace, which can later be
+	// replayed against other allocators without a GPU, see test/AllocatorReplay.cpp.
+	//
+	// Blocks are returned through this allocator so that their frees can be recorded, and are then passed on to
+	// whichever allocator they would have been returned to otherwise. Like the allocator it wraps, it may be used from
+	// any thread.
+	class RecordingPolyAllocator
+			: public PolyAllocator
+	{
+	public:
+		RecordingPolyAllocator(std::unique_ptr<PolyAllocator> allocator, std::unique_ptr<std::ostream> trace);
+		~RecordingPolyAllocator() override;
+
+
+		AllocationResult Allocate(const AllocationRequest&  allocationRequest,
+								  const MemoryTypeCriteria& memoryTypeCriteria) noexcept override;
+
+		void Free(MemoryBlock&& address) noexcept override;
+
+		[[nodiscard]] bool IsThreadSafe() const noexcept override { return mAllocator->IsThreadSafe(); }
+
+
+		void NextFrame() noexcept override;
+
+		void Trim() noexcept override;
+
+		void VisitPools(const PoolVisitor& visitor) const override;
+
+
+	private:
+		struct LiveBlock
+		{
+			uint64_t                          id;
+			// The allocator the block is returned to once its free has been recorded.
+			Core::ReflexivePointer<Allocator> owner;
+		};
+
+
+		// Returns the number of nanoseconds since recording started.
+		uint64_t Now() const noexcept;
+
+
+		std::unique_ptr<PolyAllocator>                  mAllocator;
+		std::chrono::steady_clock::time_point           mStartTime;
+
+		std::mutex                                      mMutex;
+		std::unique_ptr<std::ostream>                   mTrace;
+		uint64_t                                        mNextId = 1;
+		std::unordered_map<Address, LiveBlock>          mLiveBlocks;
+	};
+}
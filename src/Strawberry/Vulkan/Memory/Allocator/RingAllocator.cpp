@@ -0,0 +1,162 @@
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+#include "RingAllocator.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+// Standard Library
+#include <algorithm>
+
+
+//======================================================================================================================
+//  Method Definitions
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	RingAllocator::RingAllocator(MemoryPool&& memoryPool)
+		: PoolAllocator(std::move(memoryPool))
+	{
+		// Map the memory up front so that it stays mapped for the lifetime of the ring.
+		Core::Assert(Memory().Properties() & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
+		Core::AssertNEQ(Memory().GetMappedAddress(), nullptr);
+	}
+
+
+	AllocationResult RingAllocator::Allocate(const AllocationRequest& allocationRequest) noexcept
+	{
+		if (allocationRequest.requiresDedicated) [[unlikely]]
+		{
+			return AllocationError::RequiresDedicatedAllocation{};
+		}
+
+		if (Memory().Size() < allocationRequest.size) [[unlikely]]
+		{
+			return AllocationError::InsufficientPoolSize{};
+		}
+
+		// Make sure that this is one of the valid memory types for this allocation.
+		Core::Assert(allocationRequest.typeMask & (1 << Memory().GetMemoryTypeIndex().memoryTypeIndex));
+
+		// Allocations wrap around and are reclaimed out from under each other, so rather than tracking neighbours,
+		// an allocation which might conflict with one is given whole bufferImageGranularity pages of its own.
+		size_t alignment = std::max<size_t>(allocationRequest.alignment, 1);
+		size_t size      = allocationRequest.size;
+		if (MayConflict(allocationRequest.resourceKind))
+		{
+			alignment = std::max(alignment, BufferImageGranularity());
+			size      = (size + BufferImageGranularity() - 1) / BufferImageGranularity() * BufferImageGranularity();
+		}
+
+		Reclaim();
+		while (true)
+		{
+			if (Core::Optional<size_t> offset = FindSpace(size, alignment))
+			{
+				mHead = offset.Value() + size;
+				NoteResourceKind(allocationRequest.resourceKind);
+				return Memory().AllocateView(*this, offset.Value(), allocationRequest.size);
+			}
+
+			// The remaining space is all in use by allocations which have not been submitted yet.
+			if (mSubmissions.empty())
+			{
+				return AllocationError::OutOfMemory();
+			}
+
+			// Otherwise wait for the GPU to catch up.
+			const Submission& oldest = mSubmissions.front();
+			if (oldest.consumer && oldest.consumer->State() == CommandBufferState::Pending)
+			{
+				oldest.consumer->Wait();
+			}
+			Reclaim();
+		}
+	}
+
+
+	void RingAllocator::Free(MemoryBlock&& address) noexcept {}
+
+
+	void RingAllocator::VisitFreeRegions(const FreeRegionVisitor& visitor) const
+	{
+		if (mHead == mTail)
+		{
+			visitor(0, Memory().Size());
+		}
+		else if (mHead > mTail)
+		{
+			if (mTail > 0) visitor(0, mTail);
+			if (mHead < Memory().Size()) visitor(mHead, Memory().Size() - mHead);
+		}
+		else
+		{
+			visitor(mHead, mTail - mHead);
+		}
+	}
+
+
+	void RingAllocator::Retire(CommandBuffer& consumer)
+	{
+		// The command buffer may have already completed, but it must at least have been recorded.
+		Core::Assert(consumer.State() != CommandBufferState::Initial && consumer.State() != CommandBufferState::Recording);
+
+		if (mHead == mRetiredHead)
+		{
+			return;
+		}
+
+		mSubmissions.emplace_back(Submission{.consumer = Core::ReflexivePointer<CommandBuffer>(consumer), .end = mHead});
+		mRetiredHead = mHead;
+	}
+
+
+	void RingAllocator::Reclaim()
+	{
+		while (!mSubmissions.empty())
+		{
+			const Submission& oldest = mSubmissions.front();
+			if (oldest.consumer && oldest.consumer->State() == CommandBufferState::Pending)
+			{
+				break;
+			}
+
+			mTail = oldest.end;
+			mSubmissions.pop_front();
+		}
+
+		// Rewind to the start of the pool whenever the ring drains, to avoid needlessly wrapping later.
+		if (mSubmissions.empty() && mHead == mRetiredHead)
+		{
+			mHead        = 0;
+			mTail        = 0;
+			mRetiredHead = 0;
+		}
+	}
+
+
+	Core::Optional<size_t> RingAllocator::FindSpace(size_t size, size_t alignment) const noexcept
+	{
+		const size_t alignedHead = (mHead + alignment - 1) / alignment * alignment;
+
+		// The head never catches up with the tail from behind, so that mHead == mTail always means the ring is empty.
+		if (mHead >= mTail)
+		{
+			if (alignedHead + size <= Memory().Size())
+			{
+				return alignedHead;
+			}
+
+			// Wrap around to the start of the pool.
+			if (size < mTail)
+			{
+				return 0;
+			}
+		}
+		else if (alignedHead + size < mTail)
+		{
+			return alignedHead;
+		}
+
+		return Core::NullOpt;
+	}
+}
@@ -0,0 +1,74 @@
+#pragma once
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+// Strawberry Vulkan
+#include "Strawberry/Vulkan/Memory/Allocator/PoolAllocator.hpp"
+#include "Strawberry/Vulkan/Queue/CommandBuffer.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Types/Optional.hpp"
+#include "Strawberry/Core/Types/ReflexivePointer.hpp"
+// Standard Library
+#include <deque>
+
+
+//======================================================================================================================
+//  Class Declaration
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	// FIFO allocator for streaming data through a persistently mapped pool.
+	//
+	// Allocations are made one after another around a circular buffer. Once a batch of allocations has been submitted
+	// to the GPU, it is handed to Retire() along with the command buffer that reads it, and its space is reclaimed
+	// once that command buffer has finished executing. Individual blocks are never freed.
+	//
+	// When the ring is full, Allocate() waits for the oldest in-flight command buffer, which throttles the producer
+	// to the speed at which the GPU consumes the data.
+	class RingAllocator
+			: public PoolAllocator
+	{
+	public:
+		// The memory pool must be host visible.
+		RingAllocator(MemoryPool&& memoryPool);
+
+
+		AllocationResult Allocate(const AllocationRequest& allocationRequest) noexcept override;
+
+		// Does nothing. Memory is only reclaimed once the command buffer that consumed it has completed.
+		void Free(MemoryBlock&& address) noexcept override;
+
+		// Visits the space between the head and the tail of the ring.
+		void VisitFreeRegions(const FreeRegionVisitor& visitor) const override;
+
+
+		// Associates every allocation made since the last call with the given command buffer, which must already be
+		// submitted. Their space is reused once it is no longer pending.
+		void Retire(CommandBuffer& consumer);
+
+		// Reclaims the space of every retired batch whose command buffer has completed, in submission order.
+		void Reclaim();
+
+	private:
+		struct Submission
+		{
+			Core::ReflexivePointer<CommandBuffer> consumer;
+			// The head of the ring after the last allocation in this batch.
+			size_t                                end;
+		};
+
+
+		// Returns the offset at which an allocation of the given size fits, if there is one.
+		Core::Optional<size_t> FindSpace(size_t size, size_t alignment) const noexcept;
+
+
+		// The offset at which the next allocation will be attempted.
+		size_t                 mHead        = 0;
+		// The start of the oldest allocation which may still be in use. The ring is empty when this equals mHead.
+		size_t                 mTail        = 0;
+		// The value of mHead when Retire() was last called.
+		size_t                 mRetiredHead = 0;
+		// Batches of allocations which have been submitted but may not have completed, oldest first.
+		std::deque<Submission> mSubmissions;
+	};
+}
@@ -0,0 +1,246 @@
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+#include "SlabAllocator.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+// Standard Library
+#include <algorithm>
+#include <bit>
+
+
+//======================================================================================================================
+//  Method Definitions
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	SlabAllocator::SlabAllocator(MemoryPool&& memoryPool)
+		: PoolAllocator(std::move(memoryPool))
+	{
+		for (auto& sizeClasses : mPartialSlabs)
+		{
+			sizeClasses.fill(NullSlab);
+		}
+
+		// Any space at the end of the pool too small for a whole slab is left unused.
+		mSlabs.resize(Memory().Size() / SLAB_SIZE);
+		for (SlabIndex slab = static_cast<SlabIndex>(mSlabs.size()); slab-- > 0;)
+		{
+			PushSlab(mEmptySlabs, slab);
+		}
+	}
+
+
+	AllocationResult SlabAllocator::Allocate(const AllocationRequest& allocationRequest) noexcept
+	{
+		if (allocationRequest.requiresDedicated) [[unlikely]]
+		{
+			return AllocationError::RequiresDedicatedAllocation{};
+		}
+
+		if (!IsSmallAllocation(allocationRequest)) [[unlikely]]
+		{
+			return AllocationError::InsufficientPoolSize{};
+		}
+
+		// Make sure that this is one of the valid memory types for this allocation.
+		Core::Assert(allocationRequest.typeMask & (1 << Memory().GetMemoryTypeIndex().memoryTypeIndex));
+
+		// Slabs can only keep resource kinds apart if they cover whole pages, and only if the kind is known.
+		const size_t granularity = BufferImageGranularity();
+		if (granularity > 1 && (allocationRequest.resourceKind == ResourceKind::Unknown || SLAB_SIZE % granularity != 0))
+		{
+			return AllocationError::InsufficientPoolSize{};
+		}
+
+		const unsigned     sizeClass    = GetSizeClass(allocationRequest.size, allocationRequest.alignment);
+		const ResourceKind kind         = GetSlabKind(allocationRequest);
+		SlabIndex&         partialSlabs = PartialSlabs(sizeClass, kind);
+
+		// Take a slab with free slots of this size, or dedicate a new one.
+		SlabIndex slabIndex = partialSlabs;
+		if (slabIndex == NullSlab)
+		{
+			if (mEmptySlabs == NullSlab)
+			{
+				return AllocationError::OutOfMemory();
+			}
+
+			slabIndex = mEmptySlabs;
+			RemoveSlab(mEmptySlabs, slabIndex);
+			AssignSlab(slabIndex, sizeClass, kind);
+			PushSlab(partialSlabs, slabIndex);
+		}
+
+		// Claim the first free slot.
+		Slab&          slab = mSlabs[slabIndex];
+		const unsigned word = std::countr_zero(slab.summary);
+		const unsigned bit  = std::countr_zero(slab.bitmap[word]);
+		slab.bitmap[word] &= ~(uint64_t{1} << bit);
+		if (slab.bitmap[word] == 0)
+		{
+			slab.summary &= ~(uint64_t{1} << word);
+		}
+
+		if (--slab.freeCount == 0)
+		{
+			RemoveSlab(partialSlabs, slabIndex);
+		}
+
+		const size_t slot   = 64 * word + bit;
+		const size_t offset = slabIndex * SLAB_SIZE + slot * GetSlotSize(sizeClass);
+		return Memory().AllocateView(*this, offset, allocationRequest.size);
+	}
+
+
+	void SlabAllocator::Free(MemoryBlock&& address) noexcept
+	{
+		const SlabIndex slabIndex = static_cast<SlabIndex>(address.Offset() / SLAB_SIZE);
+		Slab&           slab      = mSlabs[slabIndex];
+		Core::AssertNEQ(slab.sizeClass, NoSizeClass);
+
+		const size_t   slot = (address.Offset() % SLAB_SIZE) / GetSlotSize(slab.sizeClass);
+		const unsigned word = static_cast<unsigned>(slot / 64);
+		const unsigned bit  = static_cast<unsigned>(slot % 64);
+		Core::Assert(!(slab.bitmap[word] & (uint64_t{1} << bit)));
+		slab.bitmap[word] |= uint64_t{1} << bit;
+		slab.summary      |= uint64_t{1} << word;
+
+		// A previously full slab becomes available for allocation again.
+		if (slab.freeCount++ == 0)
+		{
+			PushSlab(PartialSlabs(slab.sizeClass, slab.kind), slabIndex);
+		}
+
+		// A slab with no live slots is returned to the shared pool, so that it can serve any size class.
+		if (slab.freeCount == SLAB_SIZE / GetSlotSize(slab.sizeClass))
+		{
+			RemoveSlab(PartialSlabs(slab.sizeClass, slab.kind), slabIndex);
+			slab.sizeClass = NoSizeClass;
+			PushSlab(mEmptySlabs, slabIndex);
+		}
+	}
+
+
+	void SlabAllocator::VisitFreeRegions(const FreeRegionVisitor& visitor) const
+	{
+		// Runs of free slots are merged, including across slabs, so that an empty stretch of slabs is one region.
+		size_t runStart = 0;
+		size_t runSize  = 0;
+		auto   addFree  = [&](size_t offset, size_t size)
+		{
+			if (runSize > 0 && runStart + runSize == offset)
+			{
+				runSize += size;
+				return;
+			}
+
+			if (runSize > 0) visitor(runStart, runSize);
+			runStart = offset;
+			runSize  = size;
+		};
+
+		for (SlabIndex slabIndex = 0; slabIndex < mSlabs.size(); slabIndex++)
+		{
+			const Slab&  slab       = mSlabs[slabIndex];
+			const size_t slabOffset = slabIndex * SLAB_SIZE;
+			if (slab.sizeClass == NoSizeClass)
+			{
+				addFree(slabOffset, SLAB_SIZE);
+				continue;
+			}
+
+			const size_t slotSize = GetSlotSize(slab.sizeClass);
+			for (size_t slot = 0; slot < SLAB_SIZE / slotSize; slot++)
+			{
+				if (slab.bitmap[slot / 64] & (uint64_t{1} << (slot % 64)))
+				{
+					addFree(slabOffset + slot * slotSize, slotSize);
+				}
+			}
+		}
+
+		if (runSize > 0) visitor(runStart, runSize);
+	}
+
+
+	bool SlabAllocator::IsSmallAllocation(const AllocationRequest& allocationRequest) noexcept
+	{
+		return allocationRequest.size <= MAX_OBJECT_SIZE && allocationRequest.alignment <= MAX_OBJECT_SIZE;
+	}
+
+
+	size_t SlabAllocator::GetSlotSize(const AllocationRequest& allocationRequest) noexcept
+	{
+		return GetSlotSize(GetSizeClass(allocationRequest.size, allocationRequest.alignment));
+	}
+
+
+	unsigned SlabAllocator::GetSizeClass(size_t size, size_t alignment) noexcept
+	{
+		// Slots are aligned to their size, so a slot at least as large as the alignment is always suitably aligned.
+		const size_t slotSize = std::bit_ceil(std::max({size, alignment, MIN_OBJECT_SIZE}));
+		return std::countr_zero(slotSize) - std::countr_zero(MIN_OBJECT_SIZE);
+	}
+
+
+	ResourceKind SlabAllocator::GetSlabKind(const AllocationRequest& allocationRequest) const noexcept
+	{
+		// Without a granularity to respect, every kind can share the same slabs.
+		return BufferImageGranularity() > 1 ? allocationRequest.resourceKind : ResourceKind::Unknown;
+	}
+
+
+	void SlabAllocator::AssignSlab(SlabIndex slabIndex, unsigned sizeClass, ResourceKind kind) noexcept
+	{
+		Slab& slab = mSlabs[slabIndex];
+		slab.sizeClass = sizeClass;
+		slab.kind      = kind;
+		slab.freeCount = static_cast<uint32_t>(SLAB_SIZE / GetSlotSize(sizeClass));
+
+		// Mark the first freeCount slots as free.
+		slab.bitmap.fill(0);
+		const size_t fullWords = slab.freeCount / 64;
+		std::fill_n(slab.bitmap.begin(), fullWords, ~uint64_t{0});
+		if (const size_t remainder = slab.freeCount % 64)
+		{
+			slab.bitmap[fullWords] = (uint64_t{1} << remainder) - 1;
+		}
+
+		const size_t usedWords = (slab.freeCount + 63) / 64;
+		slab.summary = usedWords == 64 ? ~uint64_t{0} : (uint64_t{1} << usedWords) - 1;
+	}
+
+
+	void SlabAllocator::PushSlab(SlabIndex& head, SlabIndex slab) noexcept
+	{
+		mSlabs[slab].prev = NullSlab;
+		mSlabs[slab].next = head;
+		if (head != NullSlab)
+		{
+			mSlabs[head].prev = slab;
+		}
+		head = slab;
+	}
+
+
+	void SlabAllocator::RemoveSlab(SlabIndex& head, SlabIndex slab) noexcept
+	{
+		if (mSlabs[slab].prev != NullSlab)
+		{
+			mSlabs[mSlabs[slab].prev].next = mSlabs[slab].next;
+		}
+		else
+		{
+			head = mSlabs[slab].next;
+		}
+
+		if (mSlabs[slab].next != NullSlab)
+		{
+			mSlabs[mSlabs[slab].next].prev = mSlabs[slab].prev;
+		}
+
+		mSlabs[slab].prev = NullSlab;
+		mSlabs[slab].next = NullSlab;
+	}
+}
@@ -0,0 +1,114 @@
+#pragma once
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+// Strawberry Vulkan
+#include "Strawberry/Vulkan/Memory/Allocator/PoolAllocator.hpp"
+// Standard Library
+#include <array>
+#include <cstdint>
+#include <vector>
+
+
+//======================================================================================================================
+//  Class Declaration
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	// Allocator for small objects of a handful of fixed sizes.
+	//
+	// The pool is divided into equally sized slabs, each of which is dedicated on demand to a single power of two size
+	// class and subdivided into slots of that size. Every slab tracks its free slots with a two level bitmap, and slabs
+	// with free slots are kept on a list per size class, so allocating and freeing are both constant time and need no
+	// bookkeeping beyond a few bits per slot.
+	//
+	// When the device has a bufferImageGranularity greater than 1, each slab also only holds one kind of resource, so
+	// that linear and optimal resources never share a page. Requests of unknown kind are refused in that case.
+	class SlabAllocator
+			: public PoolAllocator
+	{
+	public:
+		// The size of each slab.
+		static constexpr size_t SLAB_SIZE       = 64 * 1024;
+		// The smallest size class.
+		static constexpr size_t MIN_OBJECT_SIZE = 16;
+		// The largest size class. Larger requests fail with InsufficientPoolSize.
+		static constexpr size_t MAX_OBJECT_SIZE = 4 * 1024;
+
+
+		SlabAllocator(MemoryPool&& memoryPool);
+
+
+		AllocationResult Allocate(const AllocationRequest& allocationRequest) noexcept override;
+
+		void Free(MemoryBlock&& address) noexcept override;
+
+		void VisitFreeRegions(const FreeRegionVisitor& visitor) const override;
+
+
+		// Returns whether a request of this size and alignment is served by slab allocators.
+		[[nodiscard]] static bool IsSmallAllocation(const AllocationRequest& allocationRequest) noexcept;
+
+		// Returns the size of the slots which serve a small request of this size and alignment.
+		[[nodiscard]] static size_t GetSlotSize(const AllocationRequest& allocationRequest) noexcept;
+
+	private:
+		using SlabIndex = uint32_t;
+		static constexpr SlabIndex NullSlab         = UINT32_MAX;
+		static constexpr unsigned  NoSizeClass      = UINT32_MAX;
+		static constexpr size_t    MAX_SLOTS        = SLAB_SIZE / MIN_OBJECT_SIZE;
+		static constexpr size_t    BITMAP_WORDS     = MAX_SLOTS / 64;
+		static constexpr unsigned  SIZE_CLASS_COUNT = 9;
+		static_assert(BITMAP_WORDS <= 64, "The summary word of a slab must be able to index all of its bitmap words.");
+		static_assert((MIN_OBJECT_SIZE << (SIZE_CLASS_COUNT - 1)) == MAX_OBJECT_SIZE);
+
+
+		struct Slab
+		{
+			// The size class this slab is currently dedicated to, or NoSizeClass if it is empty and unassigned.
+			unsigned                           sizeClass = NoSizeClass;
+			// The kind of resource this slab holds, when the device requires kinds to be kept apart.
+			ResourceKind                       kind      = ResourceKind::Unknown;
+			uint32_t                           freeCount = 0;
+			// Bit n is set when bitmap word n has any free slots.
+			uint64_t                           summary   = 0;
+			// Bit n of the bitmap is set when slot n is free.
+			std::array<uint64_t, BITMAP_WORDS> bitmap{};
+			// Neighbours in the list of slabs with free slots of the same size class, or the list of unassigned slabs.
+			SlabIndex                          prev      = NullSlab;
+			SlabIndex                          next      = NullSlab;
+		};
+
+
+		// Returns the size class index for the given request.
+		static unsigned GetSizeClass(size_t size, size_t alignment) noexcept;
+
+		// Returns the size of the slots in the given size class.
+		static size_t GetSlotSize(unsigned sizeClass) noexcept { return MIN_OBJECT_SIZE << sizeClass; }
+
+
+		// Returns the kind of resource which slabs for the given request must hold.
+		ResourceKind GetSlabKind(const AllocationRequest& allocationRequest) const noexcept;
+
+		// Dedicates the given unassigned slab to a size class and resource kind, marking all of its slots as free.
+		void AssignSlab(SlabIndex slab, unsigned sizeClass, ResourceKind kind) noexcept;
+
+		// Returns the head of the list of partially filled slabs of the given size class and kind.
+		SlabIndex& PartialSlabs(unsigned sizeClass, ResourceKind kind) noexcept
+		{
+			return mPartialSlabs[static_cast<size_t>(kind)][sizeClass];
+		}
+
+
+		// Functions for managing the intrusive slab lists.
+		void PushSlab(SlabIndex& head, SlabIndex slab) noexcept;
+		void RemoveSlab(SlabIndex& head, SlabIndex slab) noexcept;
+
+
+		std::vector<Slab>                                      mSlabs;
+		// Heads of the lists of slabs with at least one free slot, by resource kind and size class.
+		std::array<std::array<SlabIndex, SIZE_CLASS_COUNT>, 3> mPartialSlabs;
+		// Head of the list of slabs not dedicated to any size class.
+		SlabIndex                                              mEmptySlabs = NullSlab;
+	};
+}
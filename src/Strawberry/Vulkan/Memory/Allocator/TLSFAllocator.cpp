@@ -0,0 +1,311 @@
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+#include "TLSFAllocator.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+// Standard Library
+#include <algorithm>
+#include <bit>
+
+
+//======================================================================================================================
+//  Method Definitions
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	TLSFAllocator::TLSFAllocator(MemoryPool&& memoryPool)
+		: PoolAllocator(std::move(memoryPool))
+	{
+		for (auto& secondLevel : mFreeLists)
+		{
+			secondLevel.fill(NullBlock);
+		}
+
+		InsertFreeBlock(CreateBlock(0, Memory().Size()));
+	}
+
+
+	AllocationResult TLSFAllocator::Allocate(const AllocationRequest& allocationRequest) noexcept
+	{
+		if (allocationRequest.requiresDedicated) [[unlikely]]
+		{
+			return AllocationError::RequiresDedicatedAllocation{};
+		}
+
+		if (Memory().Size() < allocationRequest.size) [[unlikely]]
+		{
+			return AllocationError::InsufficientPoolSize{};
+		}
+
+		// Make sure that this is one of the valid memory types for this allocation.
+		Core::Assert(allocationRequest.typeMask & (1 << Memory().GetMemoryTypeIndex().memoryTypeIndex));
+
+		// Search for a block large enough to hold the allocation no matter where its aligned start falls. If it may
+		// have to be kept apart from its neighbours, also leave room to start on a fresh page and to stop short of the
+		// page of whatever follows.
+		const ResourceKind kind        = allocationRequest.resourceKind;
+		const bool         mayConflict = MayConflict(kind);
+		const size_t       granularity = BufferImageGranularity();
+		const size_t       alignment   = std::max<size_t>(allocationRequest.alignment, 1);
+		const size_t       searchSize  = mayConflict
+			? allocationRequest.size + std::max(alignment, granularity) - 1 + granularity
+			: allocationRequest.size + alignment - 1;
+		if (searchSize > Memory().Size()) [[unlikely]]
+		{
+			return AllocationError::OutOfMemory();
+		}
+
+		Core::Optional<SizeClass> sizeClass = FindFreeSizeClass(MapSearchSizeClass(searchSize));
+		if (!sizeClass)
+		{
+			return AllocationError::OutOfMemory();
+		}
+
+		BlockIndex block = mFreeLists[sizeClass->firstLevel][sizeClass->secondLevel];
+		RemoveFreeBlock(block);
+		Core::Assert(mBlocks[block].size >= searchSize);
+
+		// Return any padding skipped for alignment to the free lists.
+		// The preceding block is never free, otherwise it would have been merged with this one.
+		size_t start = (mBlocks[block].offset + alignment - 1) / alignment * alignment;
+		if (const BlockIndex prev = mBlocks[block].prevPhysical;
+			mayConflict && prev != NullBlock && ResourceKindsConflict(mBlocks[prev].kind, kind))
+		{
+			const size_t prevLastPage = (mBlocks[prev].offset + mBlocks[prev].size - 1) / granularity;
+			if (start / granularity == prevLastPage)
+			{
+				const size_t pageAlignment = std::max(alignment, granularity);
+				start = (start + pageAlignment - 1) / pageAlignment * pageAlignment;
+			}
+		}
+
+		const size_t padding = start - mBlocks[block].offset;
+		if (padding > 0)
+		{
+			BlockIndex aligned = SplitBlock(block, padding);
+			InsertFreeBlock(block);
+			block = aligned;
+		}
+
+		// Return any space beyond the end of the allocation to the free lists.
+		if (mBlocks[block].size > allocationRequest.size)
+		{
+			InsertFreeBlock(SplitBlock(block, allocationRequest.size));
+		}
+
+		mBlocks[block].kind = kind;
+		NoteResourceKind(kind);
+		return Memory().AllocateView(*this, mBlocks[block].offset, mBlocks[block].size, block);
+	}
+
+
+	void TLSFAllocator::Free(MemoryBlock&& address) noexcept
+	{
+		BlockIndex block = address.Handle();
+		Core::Assert(block < mBlocks.size() && !mBlocks[block].free);
+		Core::AssertEQ(mBlocks[block].offset, address.Offset());
+
+		// Coalesce with the following block.
+		if (BlockIndex next = mBlocks[block].nextPhysical; next != NullBlock && mBlocks[next].free)
+		{
+			RemoveFreeBlock(next);
+			MergeWithNext(block);
+		}
+
+		// Coalesce with the preceding block.
+		if (BlockIndex prev = mBlocks[block].prevPhysical; prev != NullBlock && mBlocks[prev].free)
+		{
+			RemoveFreeBlock(prev);
+			MergeWithNext(prev);
+			block = prev;
+		}
+
+		InsertFreeBlock(block);
+	}
+
+
+	void TLSFAllocator::VisitFreeRegions(const FreeRegionVisitor& visitor) const
+	{
+		// The record of the first block is created first and never retired, as it has nothing before it to merge into.
+		Core::AssertEQ(mBlocks[0].offset, 0);
+		for (BlockIndex block = 0; block != NullBlock; block = mBlocks[block].nextPhysical)
+		{
+			if (mBlocks[block].free)
+			{
+				visitor(mBlocks[block].offset, mBlocks[block].size);
+			}
+		}
+	}
+
+
+	TLSFAllocator::SizeClass TLSFAllocator::MapSizeClass(size_t size) noexcept
+	{
+		if (size < SECOND_LEVEL_COUNT)
+		{
+			return {.firstLevel = 0, .secondLevel = static_cast<unsigned>(size)};
+		}
+
+		const unsigned mostSignificantBit = std::bit_width(size) - 1;
+		return {
+			.firstLevel = mostSignificantBit - SECOND_LEVEL_LOG2 + 1,
+			.secondLevel = static_cast<unsigned>(size >> (mostSignificantBit - SECOND_LEVEL_LOG2)) ^ SECOND_LEVEL_COUNT
+		};
+	}
+
+
+	TLSFAllocator::SizeClass TLSFAllocator::MapSearchSizeClass(size_t size) noexcept
+	{
+		// Round the size up to the next size class boundary, so that any block found is guaranteed to fit.
+		if (size >= SECOND_LEVEL_COUNT)
+		{
+			const unsigned mostSignificantBit = std::bit_width(size) - 1;
+			size += (size_t{1} << (mostSignificantBit - SECOND_LEVEL_LOG2)) - 1;
+		}
+
+		return MapSizeClass(size);
+	}
+
+
+	Core::Optional<TLSFAllocator::SizeClass> TLSFAllocator::FindFreeSizeClass(SizeClass sizeClass) const noexcept
+	{
+		if (sizeClass.firstLevel >= FIRST_LEVEL_COUNT) [[unlikely]]
+		{
+			return Core::NullOpt;
+		}
+
+		// Look for a non-empty list in the same first level class.
+		uint32_t secondLevelMap = mSecondLevelBitmaps[sizeClass.firstLevel] & (~uint32_t{0} << sizeClass.secondLevel);
+		if (secondLevelMap == 0)
+		{
+			// Otherwise take the smallest non-empty first level class above it.
+			const uint64_t firstLevelMap = mFirstLevelBitmap & (~uint64_t{0} << (sizeClass.firstLevel + 1));
+			if (firstLevelMap == 0)
+			{
+				return Core::NullOpt;
+			}
+
+			sizeClass.firstLevel = std::countr_zero(firstLevelMap);
+			secondLevelMap       = mSecondLevelBitmaps[sizeClass.firstLevel];
+		}
+
+		sizeClass.secondLevel = std::countr_zero(secondLevelMap);
+		return sizeClass;
+	}
+
+
+	TLSFAllocator::BlockIndex TLSFAllocator::CreateBlock(size_t offset, size_t size)
+	{
+		BlockIndex index;
+		if (!mUnusedBlocks.empty())
+		{
+			index = mUnusedBlocks.back();
+			mUnusedBlocks.pop_back();
+		}
+		else
+		{
+			index = static_cast<BlockIndex>(mBlocks.size());
+			mBlocks.emplace_back();
+		}
+
+		mBlocks[index] = Block{.offset = offset, .size = size};
+		return index;
+	}
+
+
+	void TLSFAllocator::RetireBlock(BlockIndex block)
+	{
+		mUnusedBlocks.emplace_back(block);
+	}
+
+
+	TLSFAllocator::BlockIndex TLSFAllocator::SplitBlock(BlockIndex block, size_t size)
+	{
+		Core::Assert(size < mBlocks[block].size);
+
+		BlockIndex remainder = CreateBlock(mBlocks[block].offset + size, mBlocks[block].size - size);
+		mBlocks[block].size = size;
+
+		// Link the remainder into the physical chain.
+		mBlocks[remainder].prevPhysical = block;
+		mBlocks[remainder].nextPhysical = mBlocks[block].nextPhysical;
+		if (mBlocks[block].nextPhysical != NullBlock)
+		{
+			mBlocks[mBlocks[block].nextPhysical].prevPhysical = remainder;
+		}
+		mBlocks[block].nextPhysical = remainder;
+
+		return remainder;
+	}
+
+
+	void TLSFAllocator::MergeWithNext(BlockIndex block)
+	{
+		const BlockIndex next = mBlocks[block].nextPhysical;
+		Core::Assert(next != NullBlock);
+		Core::AssertEQ(mBlocks[block].offset + mBlocks[block].size, mBlocks[next].offset);
+
+		mBlocks[block].size        += mBlocks[next].size;
+		mBlocks[block].nextPhysical = mBlocks[next].nextPhysical;
+		if (mBlocks[next].nextPhysical != NullBlock)
+		{
+			mBlocks[mBlocks[next].nextPhysical].prevPhysical = block;
+		}
+
+		RetireBlock(next);
+	}
+
+
+	void TLSFAllocator::InsertFreeBlock(BlockIndex block)
+	{
+		const auto [firstLevel, secondLevel] = MapSizeClass(mBlocks[block].size);
+		BlockIndex& head = mFreeLists[firstLevel][secondLevel];
+
+		mBlocks[block].free     = true;
+		mBlocks[block].prevFree = NullBlock;
+		mBlocks[block].nextFree = head;
+		if (head != NullBlock)
+		{
+			mBlocks[head].prevFree = block;
+		}
+		head = block;
+
+		mFirstLevelBitmap               |= uint64_t{1} << firstLevel;
+		mSecondLevelBitmaps[firstLevel] |= uint32_t{1} << secondLevel;
+	}
+
+
+	void TLSFAllocator::RemoveFreeBlock(BlockIndex block)
+	{
+		const auto [firstLevel, secondLevel] = MapSizeClass(mBlocks[block].size);
+		Block& record = mBlocks[block];
+
+		if (record.prevFree != NullBlock)
+		{
+			mBlocks[record.prevFree].nextFree = record.nextFree;
+		}
+		else
+		{
+			mFreeLists[firstLevel][secondLevel] = record.nextFree;
+		}
+
+		if (record.nextFree != NullBlock)
+		{
+			mBlocks[record.nextFree].prevFree = record.prevFree;
+		}
+
+		record.free     = false;
+		record.prevFree = NullBlock;
+		record.nextFree = NullBlock;
+
+		// Clear the bitmaps if this list is now empty.
+		if (mFreeLists[firstLevel][secondLevel] == NullBlock)
+		{
+			mSecondLevelBitmaps[firstLevel] &= ~(uint32_t{1} << secondLevel);
+			if (mSecondLevelBitmaps[firstLevel] == 0)
+			{
+				mFirstLevelBitmap &= ~(uint64_t{1} << firstLevel);
+			}
+		}
+	}
+}
@@ -0,0 +1,126 @@
+#pragma once
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+// Strawberry Vulkan
+#include "Strawberry/Vulkan/Memory/Allocator/PoolAllocator.hpp"
+// Standard Library
+#include <array>
+#include <cstdint>
+#include <vector>
+
+
+//======================================================================================================================
+//  Class Declaration
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	// Two-Level Segregated Fit allocator.
+	//
+	// Free blocks are bucketed by size into a first level of power of two ranges, each of which is split linearly into
+	// a second level of sub-ranges. A pair of bitmaps tracks which buckets are non-empty, so that finding a free
+	// block and returning one are both constant time operations regardless of how fragmented the pool is.
+	//
+	// Once linear and optimal resources are mixed in the pool, each allocation is pushed onto a fresh
+	// bufferImageGranularity page only if its preceding neighbour is of a conflicting kind, and the search reserves a
+	// page of slack at the end so that it can never run onto the page of the block following it.
+	//
+	// Each block handed out carries the index of its record as its handle, so freeing needs no search either.
+	class TLSFAllocator
+			: public PoolAllocator
+	{
+	public:
+		TLSFAllocator(MemoryPool&& memoryPool);
+
+
+		AllocationResult Allocate(const AllocationRequest& allocationRequest) noexcept override;
+
+		void Free(MemoryBlock&& address) noexcept override;
+
+		void VisitFreeRegions(const FreeRegionVisitor& visitor) const override;
+
+	private:
+		using BlockIndex = uint32_t;
+		static constexpr BlockIndex NullBlock = UINT32_MAX;
+
+
+		// Number of second level subdivisions of each first level size class, as a power of two.
+		static constexpr unsigned SECOND_LEVEL_LOG2  = 5;
+		static constexpr unsigned SECOND_LEVEL_COUNT = 1 << SECOND_LEVEL_LOG2;
+		// Number of first level size classes. Sizes below SECOND_LEVEL_COUNT are all stored in the first class.
+		static constexpr unsigned FIRST_LEVEL_COUNT  = 64 - SECOND_LEVEL_LOG2;
+
+
+		// A contiguous range of the memory pool, either free or allocated.
+		struct Block
+		{
+			size_t       offset;
+			size_t       size;
+			bool         free         = false;
+			// The kind of resource occupying this block, when it is allocated.
+			ResourceKind kind         = ResourceKind::Unknown;
+			// Neighbours in address order.
+			BlockIndex   prevPhysical = NullBlock;
+			BlockIndex   nextPhysical = NullBlock;
+			// Neighbours within the free list of this block's size class.
+			BlockIndex   prevFree     = NullBlock;
+			BlockIndex   nextFree     = NullBlock;
+		};
+
+
+		struct SizeClass
+		{
+			unsigned firstLevel;
+			unsigned secondLevel;
+		};
+
+
+		// Returns the size class that a block of the given size belongs in.
+		static SizeClass MapSizeClass(size_t size) noexcept;
+
+		// Returns the first size class in which every block is at least the given size.
+		static SizeClass MapSearchSizeClass(size_t size) noexcept;
+
+
+		// Finds the first non-empty size class at or above the given one.
+		Core::Optional<SizeClass> FindFreeSizeClass(SizeClass sizeClass) const noexcept;
+
+
+		// Functions for managing the block storage.
+		//
+		// Creates a new block record, reusing a retired one if possible.
+		BlockIndex CreateBlock(size_t offset, size_t size);
+
+		// Returns a block record to the list of unused records.
+		void RetireBlock(BlockIndex block);
+
+		// Splits the given block so that it has the given size, and returns the index of the new block holding the remainder.
+		BlockIndex SplitBlock(BlockIndex block, size_t size);
+
+		// Merges the given block with the block physically following it, retiring the latter.
+		void MergeWithNext(BlockIndex block);
+
+
+		// Functions for managing the free lists.
+		//
+		// Insert the given block into the free list for its size.
+		void InsertFreeBlock(BlockIndex block);
+
+		// Remove the given block from the free list for its size.
+		void RemoveFreeBlock(BlockIndex block);
+
+
+		// Storage for all block records, indexed by BlockIndex.
+		std::vector<Block>      mBlocks;
+		// Indices of records within mBlocks which are not currently in use.
+		std::vector<BlockIndex> mUnusedBlocks;
+
+
+		// Bit n is set when mSecondLevelBitmaps[n] is non-zero.
+		uint64_t                                                                     mFirstLevelBitmap = 0;
+		// Bit n of entry m is set when mFreeLists[m][n] is non-empty.
+		std::array<uint32_t, FIRST_LEVEL_COUNT>                                      mSecondLevelBitmaps{};
+		// Heads of the free lists of each size class.
+		std::array<std::array<BlockIndex, SECOND_LEVEL_COUNT>, FIRST_LEVEL_COUNT>    mFreeLists;
+	};
+}
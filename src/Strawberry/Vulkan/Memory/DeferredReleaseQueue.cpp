@@ -0,0 +1,140 @@
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+#include "DeferredReleaseQueue.hpp"
+// Strawberry Vulkan
+#include "Strawberry/Vulkan/Device/Device.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/Allocator.hpp"
+// Standard Library
+#include <algorithm>
+#include <iterator>
+
+
+//======================================================================================================================
+//  Method Definitions
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	DeferredReleaseQueue::DeferredReleaseQueue(Device& device)
+		: mDevice(device)
+	{}
+
+
+	DeferredReleaseQueue::~DeferredReleaseQueue()
+	{
+		for (Release& release : mReleases)
+		{
+			DestroyHandles(release);
+		}
+		mReleases.clear();
+		mUnreclaimed.clear();
+	}
+
+
+	void DeferredReleaseQueue::ReleaseBuffer(VkBuffer buffer, MemoryBlock&& memory)
+	{
+		Enqueue(Release{.submission = 0, .memory = std::move(memory), .buffer = buffer});
+	}
+
+
+	void DeferredReleaseQueue::ReleaseImage(VkImage image, MemoryBlock&& memory)
+	{
+		Enqueue(Release{.submission = 0, .memory = std::move(memory), .image = image});
+	}
+
+
+	void DeferredReleaseQueue::ReleaseMemory(MemoryBlock&& memory)
+	{
+		Enqueue(Release{.submission = 0, .memory = std::move(memory)});
+	}
+
+
+	void DeferredReleaseQueue::Collect()
+	{
+		ZoneScoped;
+
+		const uint64_t completed = mDevice->CompletedSubmission();
+
+		std::vector<Release> ready;
+		{
+			std::scoped_lock lock(mMutex);
+			while (!mReleases.empty() && mReleases.front().submission <= completed)
+			{
+				ready.emplace_back(std::move(mReleases.front()));
+				mReleases.pop_front();
+			}
+		}
+
+		// Destroy outside of the lock, since freeing memory may take the allocator's locks.
+		std::vector<MemoryBlock> unreclaimed;
+		for (Release& release : ready)
+		{
+			DestroyHandles(release);
+
+			auto allocator = release.memory.GetAllocator();
+			if (allocator && !allocator->IsThreadSafe())
+			{
+				unreclaimed.emplace_back(std::move(release.memory));
+			}
+			else
+			{
+				release.memory = MemoryBlock();
+			}
+		}
+
+		if (!unreclaimed.empty())
+		{
+			std::scoped_lock lock(mMutex);
+			std::move(unreclaimed.begin(), unreclaimed.end(), std::back_inserter(mUnreclaimed));
+		}
+	}
+
+
+	void DeferredReleaseQueue::Reclaim(const Allocator& allocator)
+	{
+		ZoneScoped;
+
+		std::vector<MemoryBlock> reclaimed;
+		{
+			std::scoped_lock lock(mMutex);
+			auto others = std::stable_partition(mUnreclaimed.begin(), mUnreclaimed.end(), [&](const MemoryBlock& block)
+			{
+				return block.GetAllocator().Get() != &allocator;
+			});
+			std::move(others, mUnreclaimed.end(), std::back_inserter(reclaimed));
+			mUnreclaimed.erase(others, mUnreclaimed.end());
+		}
+
+		// Freed outside of the lock, like in Collect().
+		reclaimed.clear();
+	}
+
+
+	size_t DeferredReleaseQueue::PendingCount() const
+	{
+		std::scoped_lock lock(mMutex);
+		return mReleases.size() + mUnreclaimed.size();
+	}
+
+
+	void DeferredReleaseQueue::Enqueue(Release&& release)
+	{
+		// Numbering under the lock keeps the queue in submission order, whichever thread is releasing.
+		std::scoped_lock lock(mMutex);
+		release.submission = mDevice->LastSubmission();
+		mReleases.emplace_back(std::move(release));
+	}
+
+
+	void DeferredReleaseQueue::DestroyHandles(Release& release) const noexcept
+	{
+		if (release.buffer)
+		{
+			vkDestroyBuffer(mDevice->Handle(), release.buffer, nullptr);
+		}
+		if (release.image)
+		{
+			vkDestroyImage(mDevice->Handle(), release.image, nullptr);
+		}
+	}
+}
@@ -0,0 +1,94 @@
+#pragma once
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+// Strawberry Vulkan
+#include "Strawberry/Vulkan/Memory/MemoryBlock.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Types/ReflexivePointer.hpp"
+// Vulkan
+#include <vulkan/vulkan.h>
+// Standard Library
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+
+//======================================================================================================================
+//  Class Declaration
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	class Device;
+
+
+	// Holds on to the handles and memory of destroyed resources until the GPU can no longer be using them.
+	//
+	// Every submission to one of the device's queues is numbered, see Device::LastSubmission(). Anything released here
+	// is tagged with the number of the last submission made so far, and is only really destroyed by Collect() once
+	// every submission up to that number has completed. Buffers and Images release themselves here when destroyed, so
+	// they may be dropped while frames that use them are still in flight.
+	//
+	// Resources may be released from any thread, but Collect() runs on whichever thread submits, so it only frees
+	// memory into allocators which are thread safe, such as the device's allocator. The memory of other allocators,
+	// such as a MonoAllocator given to Buffer::Builder, is kept once its submissions have completed until the thread
+	// which owns that allocator calls Reclaim() with it.
+	class DeferredReleaseQueue
+	{
+	public:
+		explicit DeferredReleaseQueue(Device& device);
+		DeferredReleaseQueue(const DeferredReleaseQueue&)            = delete;
+		DeferredReleaseQueue& operator=(const DeferredReleaseQueue&) = delete;
+		// Destroys everything still waiting to be released. The device must be idle.
+		~DeferredReleaseQueue();
+
+
+		// Destroys the buffer and frees its memory once every submission made so far has completed.
+		void ReleaseBuffer(VkBuffer buffer, MemoryBlock&& memory);
+
+		// Destroys the image and frees its memory once every submission made so far has completed.
+		void ReleaseImage(VkImage image, MemoryBlock&& memory);
+
+		// Frees the memory once every submission made so far has completed.
+		void ReleaseMemory(MemoryBlock&& memory);
+
+
+		// Destroys everything whose submissions have completed, apart from memory whose allocator is not thread safe,
+		// which is kept for Reclaim(). Called whenever a queue is submitted to.
+		void Collect();
+
+		// Frees the memory released through the given allocator whose submissions have completed. Must be called from
+		// the thread which uses that allocator.
+		void Reclaim(const Allocator& allocator);
+
+
+		// Returns the number of releases which are still waiting for the GPU, or to be reclaimed.
+		[[nodiscard]] size_t PendingCount() const;
+
+
+	private:
+		struct Release
+		{
+			// The last submission which may have used the resource.
+			uint64_t    submission;
+			MemoryBlock memory;
+			VkBuffer    buffer = VK_NULL_HANDLE;
+			VkImage     image  = VK_NULL_HANDLE;
+		};
+
+
+		void Enqueue(Release&& release);
+		// Destroys the release's buffer or image, leaving its memory alone.
+		void DestroyHandles(Release& release) const noexcept;
+
+
+		Core::ReflexivePointer<Device> mDevice;
+
+		mutable std::mutex             mMutex;
+		// Releases in the order they were made, which is also the order of their submissions.
+		std::deque<Release>            mReleases;
+		// Memory whose submissions have completed, waiting for its allocator's thread to call Reclaim().
+		std::vector<MemoryBlock>       mUnreclaimed;
+	};
+}
@@ -0,0 +1,330 @@
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+#include "Defragmenter.hpp"
+#include "Strawberry/Vulkan/Device/Device.hpp"
+#include "Strawberry/Vulkan/Memory/DeferredReleaseQueue.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+// Standard Library
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+
+//======================================================================================================================
+//  Method Definitions
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	Defragmenter::Defragmenter(Device& device, size_t bytesPerStep)
+		: Defragmenter(device.GetAllocator(), bytesPerStep)
+	{}
+
+
+	Defragmenter::Defragmenter(PolyAllocator& allocator, size_t bytesPerStep)
+		: mDevice(allocator.GetDevice().Handle())
+		, mAllocator(allocator)
+		, mBytesPerStep(bytesPerStep)
+	{}
+
+
+	Defragmenter::~Defragmenter()
+	{
+		// Copies may still be reading from or writing to the pools through their pool buffers, so leave those to be
+		// destroyed along with the old buffers once the GPU has finished.
+		DeferredReleaseQueue& releases = mAllocator->GetDevice().GetDeferredReleases();
+		for (const auto& [pool, poolBuffer] : mUnretiredPoolBuffers)
+		{
+			if (poolBuffer) releases.ReleaseBuffer(poolBuffer, MemoryBlock());
+		}
+		for (const Retirement& retirement : mRetirements)
+		{
+			for (VkBuffer poolBuffer : retirement.poolBuffers)
+			{
+				releases.ReleaseBuffer(poolBuffer, MemoryBlock());
+			}
+		}
+	}
+
+
+	Defragmenter::StepResult Defragmenter::Step(CommandBuffer& commandBuffer, std::span<Buffer* const> buffers)
+	{
+		Core::Assert(commandBuffer.State() == CommandBufferState::Recording);
+
+		StepResult result;
+		result.fragmentationBefore = Fragmentation();
+
+
+		// Take a snapshot of how full each pool which is carved up by a pool allocator is. Pools handed out whole,
+		// such as dedicated allocations, have nothing to gain from being compacted.
+		struct PoolState
+		{
+			MemoryTypeIndex type;
+			size_t          size;
+			size_t          allocatedBytes;
+
+
+			double Occupancy() const noexcept { return static_cast<double>(allocatedBytes) / static_cast<double>(size); }
+		};
+		std::unordered_map<const MemoryPool*, PoolState> pools;
+		mAllocator->VisitPools([&](const MemoryPool& pool, const PoolAllocator* allocator)
+		{
+			if (allocator)
+			{
+				pools.emplace(&pool, PoolState{pool.GetMemoryTypeIndex(), pool.Size(), pool.AllocatedBytes()});
+			}
+		});
+
+
+		// Move buffers out of the emptiest pools first, as they are the closest to being released, and within each pool
+		// start with the buffers nearest its end.
+		std::vector<std::pair<Buffer*, const MemoryPool*>> candidates;
+		for (Buffer* buffer : buffers)
+		{
+			if (buffer->mMemory && pools.contains(buffer->mMemory.GetMemoryPool().Get()))
+			{
+				candidates.emplace_back(buffer, buffer->mMemory.GetMemoryPool().Get());
+			}
+		}
+		std::ranges::sort(candidates, [&](const auto& a, const auto& b)
+		{
+			return std::make_tuple(pools.at(a.second).Occupancy(), a.second, b.first->mMemory.Offset())
+				 < std::make_tuple(pools.at(b.second).Occupancy(), b.second, a.first->mMemory.Offset());
+		});
+
+
+		struct Copy
+		{
+			VkBuffer     source;
+			VkBuffer     destination;
+			VkBufferCopy region;
+		};
+		std::vector<Copy> copies;
+		for (const auto& [buffer, sourcePool] : candidates)
+		{
+			const size_t size = buffer->mMemory.Size();
+			if (result.movedBytes + size > mBytesPerStep)
+			{
+				continue;
+			}
+
+			// Only move the buffer if some fuller pool of the same memory type has room for it, so that it is not
+			// placed in a new pool, or one which is no closer to being full.
+			PoolState& source = pools.at(sourcePool);
+			const bool hasDestination = std::ranges::any_of(pools, [&](const auto& entry)
+			{
+				const auto& [pool, state] = entry;
+				return pool != sourcePool
+					&& state.type == source.type
+					&& state.Occupancy() > source.Occupancy()
+					&& state.size - state.allocatedBytes >= size;
+			});
+			const VkBuffer sourceBuffer = hasDestination ? GetPoolBuffer(*sourcePool) : VK_NULL_HANDLE;
+			if (!sourceBuffer)
+			{
+				continue;
+			}
+
+			// Allocate in the same way as the buffer was, but only from the memory type it is in already.
+			AllocationRequest request = buffer->GetAllocationRequest(mDevice);
+			request.typeMask &= 1u << source.type.memoryTypeIndex;
+			if (request.IsDedicated() || request.typeMask == 0)
+			{
+				continue;
+			}
+			const MemoryTypeCriteria criteria{.requiredProperties = source.type.GetProperties()};
+			AllocationResult allocation = mAllocator->Allocate(request, criteria);
+			if (!allocation)
+			{
+				continue;
+			}
+
+			// The allocator may still have placed the block somewhere which does not help, in which case it is freed
+			// straight away, as nothing has used it.
+			MemoryBlock memory = allocation.Unwrap();
+			const MemoryPool* destinationPool = memory.GetMemoryPool().Get();
+			auto destination = pools.find(destinationPool);
+			if (destination == pools.end() || destinationPool == sourcePool || destination->second.Occupancy() <= source.Occupancy())
+			{
+				continue;
+			}
+			const VkBuffer destinationBuffer = GetPoolBuffer(*destinationPool);
+			if (!destinationBuffer)
+			{
+				continue;
+			}
+
+			copies.emplace_back(Copy{
+				.source = sourceBuffer,
+				.destination = destinationBuffer,
+				.region = VkBufferCopy{
+					.srcOffset = buffer->mMemory.Offset(),
+					.dstOffset = memory.Offset(),
+					.size = size
+				}
+			});
+			source.allocatedBytes              -= size;
+			destination->second.allocatedBytes += size;
+
+			Buffer moved(mDevice, buffer->mSize, buffer->mUsage);
+			Core::AssertEQ(vkBindBufferMemory(mDevice, moved.mHandle, memory.Memory(), memory.Offset()), VK_SUCCESS);
+			moved.mMemory = std::move(memory);
+
+			std::swap(*buffer, moved);
+			mUnretiredBuffers.emplace_back(std::move(moved));
+			result.movedBuffers.emplace_back(buffer);
+			result.movedBytes += size;
+		}
+
+		if (copies.empty())
+		{
+			return result;
+		}
+
+		// Wait for all prior use of the pools before copying, and make the copies visible to everything after.
+		commandBuffer.PipelineBarrier(
+			VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			0,
+			{
+				VkMemoryBarrier{
+					.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+					.pNext = nullptr,
+					.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT,
+					.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT
+				}
+			});
+		for (const Copy& copy : copies)
+		{
+			vkCmdCopyBuffer(commandBuffer, copy.source, copy.destination, 1, &copy.region);
+		}
+		commandBuffer.PipelineBarrier(
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+			0,
+			{
+				VkMemoryBarrier{
+					.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+					.pNext = nullptr,
+					.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+					.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT
+				}
+			});
+
+		return result;
+	}
+
+
+	void Defragmenter::Retire(CommandBuffer& commandBuffer)
+	{
+		// The command buffer may have already completed, but it must at least have been recorded.
+		Core::Assert(commandBuffer.State() != CommandBufferState::Initial && commandBuffer.State() != CommandBufferState::Recording);
+
+		if (mUnretiredBuffers.empty() && mUnretiredPoolBuffers.empty())
+		{
+			return;
+		}
+
+		Retirement retirement{
+			.commandBuffer = Core::ReflexivePointer<CommandBuffer>(commandBuffer),
+			.oldBuffers = std::move(mUnretiredBuffers)
+		};
+		for (const auto& [pool, poolBuffer] : mUnretiredPoolBuffers)
+		{
+			if (poolBuffer) retirement.poolBuffers.emplace_back(poolBuffer);
+		}
+		mRetirements.emplace_back(std::move(retirement));
+		mUnretiredBuffers.clear();
+		mUnretiredPoolBuffers.clear();
+	}
+
+
+	double Defragmenter::Collect()
+	{
+		while (!mRetirements.empty())
+		{
+			Retirement& oldest = mRetirements.front();
+			if (oldest.commandBuffer && oldest.commandBuffer->State() == CommandBufferState::Pending)
+			{
+				break;
+			}
+
+			Release(oldest);
+			mRetirements.pop_front();
+		}
+
+		return Fragmentation();
+	}
+
+
+	double Defragmenter::Fragmentation() const
+	{
+		MemoryUsage usage;
+		mAllocator->VisitPools([&](const MemoryPool& pool, const PoolAllocator* allocator)
+		{
+			if (allocator)
+			{
+				usage += MemoryUsage::Of(pool, allocator);
+			}
+		});
+		return usage.Fragmentation();
+	}
+
+
+	VkBuffer Defragmenter::GetPoolBuffer(const MemoryPool& pool)
+	{
+		if (auto poolBuffer = mUnretiredPoolBuffers.find(&pool); poolBuffer != mUnretiredPoolBuffers.end())
+		{
+			return poolBuffer->second;
+		}
+
+		// Copies are made within buffers spanning whole pools, so that buffers can be moved whatever their usage.
+		VkBufferCreateInfo createInfo{
+			.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.size = pool.Size(),
+			.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+			.queueFamilyIndexCount = 0,
+			.pQueueFamilyIndices = nullptr,
+		};
+		VkBuffer poolBuffer = VK_NULL_HANDLE;
+		Core::AssertEQ(vkCreateBuffer(mDevice, &createInfo, nullptr, &poolBuffer), VK_SUCCESS);
+
+		VkMemoryRequirements memoryRequirements;
+		vkGetBufferMemoryRequirements(mDevice, poolBuffer, &memoryRequirements);
+		if (memoryRequirements.memoryTypeBits & (1 << pool.GetMemoryTypeIndex().memoryTypeIndex) && memoryRequirements.size <= pool.Size())
+		{
+			Core::AssertEQ(vkBindBufferMemory(mDevice, poolBuffer, pool.Memory(), 0), VK_SUCCESS);
+		}
+		else
+		{
+			// Transfer buffers cannot live in this pool's memory type, so buffers in it cannot be moved.
+			vkDestroyBuffer(mDevice, poolBuffer, nullptr);
+			poolBuffer = VK_NULL_HANDLE;
+		}
+
+		mUnretiredPoolBuffers.emplace(&pool, poolBuffer);
+		return poolBuffer;
+	}
+
+
+	void Defragmenter::Release(Retirement& retirement) const
+	{
+		for (VkBuffer poolBuffer : retirement.poolBuffers)
+		{
+			vkDestroyBuffer(mDevice, poolBuffer, nullptr);
+		}
+		retirement.poolBuffers.clear();
+
+		// The copies out of the old buffers have completed, so they are destroyed now rather than left for the device
+		// to release later, so that their memory is back with the allocator by the time Collect() measures it.
+		for (Buffer& oldBuffer : retirement.oldBuffers)
+		{
+			vkDestroyBuffer(mDevice, std::exchange(oldBuffer.mHandle, VK_NULL_HANDLE), nullptr);
+		}
+		retirement.oldBuffers.clear();
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+// Strawberry Vulkan
+#include "Strawberry/Vulkan/Memory/Allocator/PolyAllocator.hpp"
+#include "Strawberry/Vulkan/Queue/CommandBuffer.hpp"
+#include "Strawberry/Vulkan/Resource/Buffer.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Types/ReflexivePointer.hpp"
+// Vulkan
+#include <vulkan/vulkan.h>
+// Standard Library
+#include <deque>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+
+//======================================================================================================================
+//  Class Declaration
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	class Device;
+
+
+	// Incrementally compacts the buffers living in a PolyAllocator's pools, such as those of the device's allocator.
+	//
+	// Each call to Step() moves buffers out of the emptiest pools of each memory type into the free space of fuller
+	// pools of the same type, by recording copies into a command buffer and giving each moved Buffer a new handle bound
+	// to its new memory. Pools which are emptied can then be released by the allocator's NextFrame() or Trim(), and
+	// the free space gathered into fewer pools leaves room for large requests which would otherwise fall through to
+	// dedicated allocations. At most a fixed number of bytes are moved per step, so that defragmentation can run
+	// alongside rendering every frame without causing a hitch. Descriptor sets referring to a moved buffer must be
+	// rewritten by the caller.
+	//
+	// The old handles and memory of moved buffers are kept alive until the command buffer which copied them has
+	// completed. Like RingAllocator, the command buffer is handed to Retire() once it has been submitted, and
+	// Collect() releases everything whose copies have finished.
+	class Defragmenter
+	{
+	public:
+		struct StepResult
+		{
+			// The buffers which were moved, and now have new handles.
+			std::vector<Buffer*> movedBuffers;
+			// The number of bytes copied.
+			size_t               movedBytes          = 0;
+			// The fragmentation of the pools before this step, see Fragmentation().
+			double               fragmentationBefore = 0.0;
+		};
+
+
+		// Compacts the pools of the device's allocator.
+		Defragmenter(Device& device, size_t bytesPerStep);
+		Defragmenter(PolyAllocator& allocator, size_t bytesPerStep);
+		Defragmenter(const Defragmenter&)            = delete;
+		Defragmenter& operator=(const Defragmenter&) = delete;
+		~Defragmenter();
+
+
+		// Records moves of up to bytesPerStep bytes of the given buffers into the given command buffer, which must be
+		// recording. Buffers which were not suballocated from this defragmenter's allocator are ignored.
+		StepResult Step(CommandBuffer& commandBuffer, std::span<Buffer* const> buffers);
+
+		// Associates the old memory of every buffer moved since the last call with the given command buffer, which must
+		// already be submitted. That memory is returned to the allocator once the command buffer has completed.
+		void Retire(CommandBuffer& commandBuffer);
+
+		// Returns the old memory of buffers whose copies have completed to the allocator, and returns the fragmentation
+		// of the pools afterwards, so that it can be compared against StepResult::fragmentationBefore.
+		double Collect();
+
+
+		// Returns the current fragmentation of the allocator's pools, see MemoryUsage::Fragmentation(). This only
+		// improves as old memory is collected.
+		double Fragmentation() const;
+
+
+	private:
+		struct Retirement
+		{
+			Core::ReflexivePointer<CommandBuffer> commandBuffer;
+			std::vector<Buffer>                   oldBuffers;
+			std::vector<VkBuffer>                 poolBuffers;
+		};
+
+
+		// Returns a buffer spanning the whole of the given pool, which copies into and out of it are made through,
+		// creating it if this step has not needed it yet. Returns VK_NULL_HANDLE if no such buffer can live in the pool.
+		VkBuffer GetPoolBuffer(const MemoryPool& pool);
+
+		// Destroys the old buffers and pool buffers of a retirement whose copies have completed.
+		void Release(Retirement& retirement) const;
+
+
+		VkDevice                              mDevice;
+		Core::ReflexivePointer<PolyAllocator> mAllocator;
+		size_t                                mBytesPerStep;
+
+
+		// Buffers which have been moved away from since the last call to Retire(), and the pool buffers their copies
+		// were made through.
+		std::vector<Buffer>                                 mUnretiredBuffers;
+		std::unordered_map<const MemoryPool*, VkBuffer>     mUnretiredPoolBuffers;
+		// Buffers which have been moved away from, waiting for their copies to complete, oldest first.
+		std::deque<Retirement>                              mRetirements;
+	};
+}
@@ -0,0 +1,102 @@
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+#include "HostMemoryImporter.hpp"
+// Strawberry Vulkan
+#include "Strawberry/Vulkan/Device/Device.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+// Standard Library
+#include <algorithm>
+
+
+//======================================================================================================================
+//  Method Definitions
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	HostMemoryImporter::HostMemoryImporter(Device& device)
+		: Allocator(device)
+	{
+		mAlignment = device.GetPhysicalDevice().GetMinImportedHostPointerAlignment();
+		if (mAlignment)
+		{
+			mGetMemoryHostPointerProperties = reinterpret_cast<PFN_vkGetMemoryHostPointerPropertiesEXT>(
+				vkGetDeviceProcAddr(device.Handle(), "vkGetMemoryHostPointerPropertiesEXT"));
+			Core::AssertNEQ(mGetMemoryHostPointerProperties, nullptr);
+		}
+	}
+
+
+	bool HostMemoryImporter::CanImport(const void* hostPointer, size_t size) const noexcept
+	{
+		return mAlignment
+			&& hostPointer != nullptr
+			&& size > 0
+			&& reinterpret_cast<uintptr_t>(hostPointer) % mAlignment.Value() == 0
+			&& size % mAlignment.Value() == 0;
+	}
+
+
+	AllocationResult HostMemoryImporter::Import(const void* hostPointer, size_t size, uint32_t typeMask)
+	{
+		ZoneScoped;
+
+		Core::Assert(CanImport(hostPointer, size));
+
+		// Vulkan takes a mutable pointer, but the device only writes through it if the resources bound to it are written.
+		void* pointer = const_cast<void*>(hostPointer);
+
+		VkMemoryHostPointerPropertiesEXT pointerProperties
+		{
+			.sType = VK_STRUCTURE_TYPE_MEMORY_HOST_POINTER_PROPERTIES_EXT,
+			.pNext = nullptr,
+		};
+		Core::AssertEQ(
+			mGetMemoryHostPointerProperties(
+				GetDevice().Handle(),
+				VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT,
+				pointer,
+				&pointerProperties),
+			VK_SUCCESS);
+
+		// Take the most suitable type for host data which the pointer can be imported as.
+		const uint32_t allowedTypes = pointerProperties.memoryTypeBits & typeMask;
+		const auto memoryTypes = GetDevice().GetPhysicalDevice().SearchMemoryTypes(MemoryTypeCriteria::HostVisible());
+		auto memoryType = std::ranges::find_if(memoryTypes, [&](const MemoryType& type)
+		{
+			return allowedTypes & (1 << type.index.memoryTypeIndex);
+		});
+		if (memoryType == memoryTypes.end())
+		{
+			return AllocationError::OutOfMemory();
+		}
+
+		auto memoryPoolResult = MemoryPool::Import(GetDevice(), memoryType->index, pointer, size);
+		if (!memoryPoolResult)
+		{
+			return AllocationError::OutOfMemory();
+		}
+
+		MemoryPool memoryPool = memoryPoolResult.Unwrap();
+		MemoryBlock allocation = memoryPool.AllocateView(*this, 0, size);
+
+		std::lock_guard lock(mMutex);
+		mImports.emplace(allocation.Address(), std::move(memoryPool));
+		return allocation;
+	}
+
+
+	void HostMemoryImporter::Free(MemoryBlock&& block) noexcept
+	{
+		std::lock_guard lock(mMutex);
+		mImports.erase(block.Address());
+	}
+
+
+	size_t HostMemoryImporter::ImportCount() const
+	{
+		std::lock_guard lock(mMutex);
+		return mImports.size();
+	}
+}
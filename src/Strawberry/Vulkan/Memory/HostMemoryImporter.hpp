@@ -0,0 +1,65 @@
+#pragma once
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+// Strawberry Vulkan
+#include "Strawberry/Vulkan/Memory/Allocator/MonoAllocator.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Types/Optional.hpp"
+// Vulkan
+#include <vulkan/vulkan.h>
+// Standard Library
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+
+//======================================================================================================================
+//  Class Declaration
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	class Device;
+
+
+	// Wraps memory which the host has already allocated as blocks of device memory, using VK_EXT_external_memory_host,
+	// so that large data can be read by the device in place rather than copied into memory of its own.
+	//
+	// Each import is a memory pool of its own, which is freed along with its block. The host memory must outlive
+	// the block, and so any GPU work using it. Imports may be made and freed from any thread.
+	//
+	// Every device has one of these, see Device::GetHostMemoryImporter(), which is used by
+	// Buffer::Builder::WithHostData().
+	class HostMemoryImporter
+		: public Allocator
+	{
+	public:
+		explicit HostMemoryImporter(Device& device);
+
+
+		// Returns whether the given range of host memory can be imported, which needs the extension, and the address
+		// and size to be multiples of minImportedHostPointerAlignment.
+		[[nodiscard]] bool CanImport(const void* hostPointer, size_t size) const noexcept;
+
+
+		// Imports the given range of host memory, in a memory type which is also in the given mask.
+		AllocationResult Import(const void* hostPointer, size_t size, uint32_t typeMask = ~0u);
+
+		// Frees the memory pool of the given import. The host memory itself is left alone.
+		void Free(MemoryBlock&& block) noexcept override;
+
+		[[nodiscard]] bool IsThreadSafe() const noexcept override { return true; }
+
+
+		// Returns the number of imports which have not been freed.
+		[[nodiscard]] size_t ImportCount() const;
+
+
+	private:
+		PFN_vkGetMemoryHostPointerPropertiesEXT mGetMemoryHostPointerProperties = nullptr;
+		Core::Optional<VkDeviceSize>            mAlignment;
+
+		mutable std::mutex                      mMutex;
+		std::unordered_map<Address, MemoryPool> mImports;
+	};
+}
@@ -0,0 +1,87 @@
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+#include "MappedRangeBatch.hpp"
+// Strawberry Vulkan
+#include "Strawberry/Vulkan/Device/Device.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+// Standard Library
+#include <algorithm>
+#include <tuple>
+
+
+//======================================================================================================================
+//  Method Definitions
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	MappedRangeBatch::MappedRangeBatch(const Device& device)
+		: mDevice(device.Handle())
+	{}
+
+
+	void MappedRangeBatch::Add(const MemoryBlock& block, size_t offset, size_t size)
+	{
+		Core::AssertEQ(block.GetDevice().Handle(), mDevice);
+		if (block.Properties() & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) return;
+
+		const VkMappedMemoryRange range = block.MappedRange(offset, size);
+		if (range.size > 0)
+		{
+			mRanges.emplace_back(range);
+		}
+	}
+
+
+	void MappedRangeBatch::Flush()
+	{
+		ZoneScoped;
+
+		if (mRanges.empty()) return;
+
+		const uint32_t count = Coalesce();
+		Core::AssertEQ(vkFlushMappedMemoryRanges(mDevice, count, mRanges.data()), VK_SUCCESS);
+		mRanges.clear();
+	}
+
+
+	void MappedRangeBatch::Invalidate()
+	{
+		ZoneScoped;
+
+		if (mRanges.empty()) return;
+
+		const uint32_t count = Coalesce();
+		Core::AssertEQ(vkInvalidateMappedMemoryRanges(mDevice, count, mRanges.data()), VK_SUCCESS);
+		mRanges.clear();
+	}
+
+
+	uint32_t MappedRangeBatch::Coalesce()
+	{
+		std::ranges::sort(mRanges, [](const VkMappedMemoryRange& a, const VkMappedMemoryRange& b)
+		{
+			return std::tie(a.memory, a.offset) < std::tie(b.memory, b.offset);
+		});
+
+		// Every range is already a whole number of atoms, so merged ranges are too.
+		size_t merged = 0;
+		for (size_t i = 1; i < mRanges.size(); i++)
+		{
+			VkMappedMemoryRange& last = mRanges[merged];
+			const VkMappedMemoryRange& next = mRanges[i];
+			if (next.memory == last.memory && next.offset <= last.offset + last.size)
+			{
+				last.size = std::max(last.offset + last.size, next.offset + next.size) - last.offset;
+			}
+			else
+			{
+				mRanges[++merged] = next;
+			}
+		}
+
+		mRanges.resize(merged + 1);
+		return static_cast<uint32_t>(mRanges.size());
+	}
+}
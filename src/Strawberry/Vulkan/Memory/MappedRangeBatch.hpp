@@ -0,0 +1,56 @@
+#pragma once
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+// Strawberry Vulkan
+#include "Strawberry/Vulkan/Memory/MemoryBlock.hpp"
+// Vulkan
+#include <vulkan/vulkan.h>
+// Standard Library
+#include <vector>
+
+
+//======================================================================================================================
+//  Class Declaration
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	class Device;
+
+
+	// Gathers ranges of non-coherent mapped memory which have been written, or are about to be read, so that they can
+	// all be flushed or invalidated with a single call instead of one per write.
+	//
+	// Ranges are widened to nonCoherentAtomSize as they are added, and overlapping or adjacent ranges of the same
+	// device memory are merged before being handed to Vulkan. Ranges of host coherent memory are ignored.
+	class MappedRangeBatch
+	{
+	public:
+		explicit MappedRangeBatch(const Device& device);
+
+
+		// Adds the given range of a block, relative to the start of the block.
+		void Add(const MemoryBlock& block, size_t offset = 0, size_t size = VK_WHOLE_SIZE);
+
+
+		// Flushes every range added since the last flush or invalidation with one call to vkFlushMappedMemoryRanges.
+		void Flush();
+
+		// Invalidates every range added since the last flush or invalidation with one call to
+		// vkInvalidateMappedMemoryRanges.
+		void Invalidate();
+
+
+		// Returns whether there are no ranges waiting to be flushed or invalidated.
+		[[nodiscard]] bool Empty() const noexcept { return mRanges.empty(); }
+
+
+	private:
+		// Sorts the ranges and merges those which touch, returning how many are left.
+		uint32_t Coalesce();
+
+
+		VkDevice                         mDevice;
+		std::vector<VkMappedMemoryRange> mRanges;
+	};
+}
@@ -29,11 +29,21 @@ namespace Strawberry::Vulkan
 	struct MemoryType
 	{
 		MemoryTypeIndex       index;
+		uint32_t              heapIndex;
 		size_t                heapSize;
 		VkMemoryPropertyFlags properties;
 	};
 
 
+	struct MemoryHeapBudget
+	{
+		// How many bytes of this heap the process can use before allocations are likely to fail or degrade.
+		VkDeviceSize budget;
+		// How many bytes of this heap the process is currently using.
+		VkDeviceSize usage;
+	};
+
+
 	struct Address
 	{
 		VkDeviceMemory deviceMemory = VK_NULL_HANDLE;
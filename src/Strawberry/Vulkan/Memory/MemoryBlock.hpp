@@ -16,7 +16,7 @@ namespace Strawberry::Vulkan
 	{
 	public:
 		MemoryBlock() = default;
-		MemoryBlock(Allocator& allocator, MemoryPool& allocation, size_t offset, size_t size);
+		MemoryBlock(Allocator& allocator, MemoryPool& allocation, size_t offset, size_t size, uint32_t handle = 0);
 		MemoryBlock(const MemoryBlock&)            = delete;
 		MemoryBlock& operator=(const MemoryBlock&) = delete;
 		MemoryBlock(MemoryBlock&& other) noexcept;
@@ -27,25 +27,49 @@ namespace Strawberry::Vulkan
 		explicit operator bool() const noexcept;
 
 
-		[[nodiscard]]       Device&                     GetDevice()       noexcept;
-		[[nodiscard]] const Device&                     GetDevice() const noexcept;
-		[[nodiscard]] Core::ReflexivePointer<Allocator> GetAllocator() const noexcept;
-		[[nodiscard]] Address                           Address() const noexcept;
-		[[nodiscard]] VkDeviceMemory                    Memory() const noexcept;
-		[[nodiscard]] size_t                            Offset() const noexcept;
-		[[nodiscard]] size_t                            Size() const noexcept;
-		[[nodiscard]] VkMemoryPropertyFlags             Properties() const;
-		[[nodiscard]] uint8_t*                          GetMappedAddress() const noexcept;
+		[[nodiscard]]       Device&                      GetDevice()       noexcept;
+		[[nodiscard]] const Device&                      GetDevice() const noexcept;
+		[[nodiscard]] Core::ReflexivePointer<Allocator>  GetAllocator() const noexcept;
+		// Returns the allocator which carved this block out of its pool. Unlike GetAllocator(), this is never changed
+		// by Reassign(), so that allocators which hand out blocks carved by others can pass them straight back.
+		[[nodiscard]] Core::ReflexivePointer<Allocator>  GetOwner() const noexcept;
+		[[nodiscard]] Core::ReflexivePointer<MemoryPool> GetMemoryPool() const noexcept;
+		[[nodiscard]] Address                            Address() const noexcept;
+		[[nodiscard]] VkDeviceMemory                     Memory() const noexcept;
+		[[nodiscard]] size_t                             Offset() const noexcept;
+		[[nodiscard]] size_t                             Size() const noexcept;
+		// A value which the allocator that carved this block stored in it, so that it can find its own record of the
+		// block again in constant time when it is freed.
+		[[nodiscard]] uint32_t                           Handle() const noexcept;
+		[[nodiscard]] VkMemoryPropertyFlags              Properties() const;
+		[[nodiscard]] uint8_t*                           GetMappedAddress() const noexcept;
 
 
-		void Flush() const noexcept;
+		// Makes host writes to the given range of this block visible to the device. The range is relative to the
+		// start of the block, and widened to nonCoherentAtomSize. Does nothing for host coherent memory.
+		void Flush(size_t offset = 0, size_t size = VK_WHOLE_SIZE) const noexcept;
+		// Makes device writes to the given range of this block visible to the host, for reading back. The range is
+		// treated as for Flush(). Does nothing for host coherent memory.
+		void Invalidate(size_t offset = 0, size_t size = VK_WHOLE_SIZE) const noexcept;
+		// Returns the range of device memory which Flush() or Invalidate() would operate on.
+		[[nodiscard]] VkMappedMemoryRange MappedRange(size_t offset = 0, size_t size = VK_WHOLE_SIZE) const noexcept;
+
 		void Overwrite(const Core::IO::DynamicByteBuffer& bytes) const noexcept;
 
 
+		// Makes the given allocator responsible for freeing this block from now on. Used by allocators which hand out
+		// blocks carved out by other allocators, and need them to be returned through themselves.
+		void Reassign(Allocator& allocator) noexcept;
+
+
 	private:
+		// The allocator to which this block is returned on destruction, which is its owner unless it has been reassigned.
 		Core::ReflexivePointer<Allocator>  mAllocator  = nullptr;
+		// The allocator which carved this block out of its pool.
+		Core::ReflexivePointer<Allocator>  mOwner      = nullptr;
 		Core::ReflexivePointer<MemoryPool> mMemoryPool = nullptr;
 		size_t                             mOffset     = 0;
 		size_t                             mSize       = 0;
+		uint32_t                           mHandle     = 0;
 	};
 }
\ No newline at end of file
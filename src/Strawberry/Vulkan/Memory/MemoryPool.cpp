@@ -1,4 +1,5 @@
 #include "MemoryPool.hpp"
+#include <algorithm>
 
 
 namespace Strawberry::Vulkan
@@ -6,10 +7,53 @@ namespace Strawberry::Vulkan
 	Core::Result<MemoryPool, AllocationError> MemoryPool::Allocate(Device& device, MemoryTypeIndex memoryTypeIndex,
 																   size_t size)
 	{
+		return Allocate(device, memoryTypeIndex, size, nullptr);
+	}
+
+
+	Core::Result<MemoryPool, AllocationError> MemoryPool::AllocateDedicated(Device& device, MemoryTypeIndex memoryTypeIndex,
+																			size_t size, VkBuffer buffer, VkImage image, float priority)
+	{
+		Core::Assert((buffer == VK_NULL_HANDLE) != (image == VK_NULL_HANDLE));
+
+		const VkMemoryDedicatedAllocateInfo dedicatedAllocateInfo
+		{
+			.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO,
+			.pNext = nullptr,
+			.image = image,
+			.buffer = buffer,
+		};
+		return Allocate(device, memoryTypeIndex, size, &dedicatedAllocateInfo, priority);
+	}
+
+
+	Core::Result<MemoryPool, AllocationError> MemoryPool::Import(Device& device, MemoryTypeIndex memoryTypeIndex,
+																 void* hostPointer, size_t size)
+	{
+		const VkImportMemoryHostPointerInfoEXT importInfo
+		{
+			.sType = VK_STRUCTURE_TYPE_IMPORT_MEMORY_HOST_POINTER_INFO_EXT,
+			.pNext = nullptr,
+			.handleType = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT,
+			.pHostPointer = hostPointer,
+		};
+		return Allocate(device, memoryTypeIndex, size, &importInfo);
+	}
+
+
+	Core::Result<MemoryPool, AllocationError> MemoryPool::Allocate(Device& device, MemoryTypeIndex memoryTypeIndex,
+																   size_t size, const void* next, float priority)
+	{
+		const VkMemoryPriorityAllocateInfoEXT priorityInfo
+		{
+			.sType = VK_STRUCTURE_TYPE_MEMORY_PRIORITY_ALLOCATE_INFO_EXT,
+			.pNext = next,
+			.priority = priority,
+		};
 		const VkMemoryAllocateInfo allocateInfo
 		{
 			.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-			.pNext = nullptr,
+			.pNext = device.HasMemoryPriority() ? &priorityInfo : next,
 			.allocationSize = size,
 			.memoryTypeIndex = memoryTypeIndex.memoryTypeIndex,
 		};
@@ -37,13 +81,20 @@ namespace Strawberry::Vulkan
 		  , mSize(size) {}
 
 
+	MemoryPool::MemoryPool(MemoryTypeIndex memoryTypeIndex, size_t size)
+		: mMemoryTypeIndex(memoryTypeIndex)
+		  , mSize(size) {}
+
+
 	MemoryPool::MemoryPool(MemoryPool&& other) noexcept
 		: EnableReflexivePointer(std::move(other))
 		  , mDevice(std::move(other.mDevice))
 		  , mMemoryTypeIndex(std::exchange(other.mMemoryTypeIndex, {}))
 		  , mMemory(std::exchange(other.mMemory, VK_NULL_HANDLE))
 		  , mSize(std::exchange(other.mSize, 0))
-		  , mMappedAddress(std::move(other.mMappedAddress)) {}
+		  , mMappedAddress(std::move(other.mMappedAddress))
+		  , mAllocatedBlockCount(other.mAllocatedBlockCount.exchange(0))
+		  , mAllocatedBytes(other.mAllocatedBytes.exchange(0)) {}
 
 
 	MemoryPool& MemoryPool::operator=(MemoryPool&& other) noexcept
@@ -67,9 +118,16 @@ namespace Strawberry::Vulkan
 	}
 
 
-	MemoryBlock MemoryPool::AllocateView(Allocator& allocator, size_t offset, size_t size)
+	MemoryBlock MemoryPool::AllocateView(Allocator& allocator, size_t offset, size_t size, uint32_t handle)
 	{
-		return { allocator, *this, offset, size };
+		mAllocatedBlockCount += 1;
+		mAllocatedBytes      += size;
+		return { allocator, *this, offset, size, handle };
+	}
+
+	bool MemoryPool::HasDevice() const noexcept
+	{
+		return static_cast<bool>(mDevice);
 	}
 
 	Device& MemoryPool::GetDevice() const noexcept
@@ -93,6 +151,24 @@ namespace Strawberry::Vulkan
 	}
 
 
+	size_t MemoryPool::AllocatedBlockCount() const noexcept
+	{
+		return mAllocatedBlockCount;
+	}
+
+
+	size_t MemoryPool::AllocatedBytes() const noexcept
+	{
+		return mAllocatedBytes;
+	}
+
+
+	bool MemoryPool::IsEmpty() const noexcept
+	{
+		return mAllocatedBlockCount == 0;
+	}
+
+
 	VkMemoryPropertyFlags MemoryPool::Properties() const
 	{
 		return mMemoryTypeIndex.GetProperties();
@@ -112,6 +188,24 @@ namespace Strawberry::Vulkan
 	}
 
 
+	VkMappedMemoryRange MemoryPool::MappedRange(size_t offset, size_t size) const noexcept
+	{
+		Core::Assert(offset + size <= mSize);
+
+		const size_t atomSize = mDevice->GetPhysicalDevice().GetLimits().nonCoherentAtomSize;
+		const size_t begin    = offset / atomSize * atomSize;
+		const size_t end      = std::min((offset + size + atomSize - 1) / atomSize * atomSize, mSize);
+		return VkMappedMemoryRange
+		{
+			.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,
+			.pNext = nullptr,
+			.memory = mMemory,
+			.offset = begin,
+			.size = end - begin
+		};
+	}
+
+
 	void MemoryPool::Flush() const noexcept
 	{
 		VkMappedMemoryRange range
@@ -4,6 +4,7 @@
 #include "../Device/Device.hpp"
 #include "Strawberry/Core/Types/Result.hpp"
 #include "Strawberry/Core/Types/ReflexivePointer.hpp"
+#include <atomic>
 
 
 namespace Strawberry::Vulkan
@@ -15,12 +16,24 @@ namespace Strawberry::Vulkan
 	class MemoryPool final
 			: public Core::EnableReflexivePointer
 	{
+		friend class MemoryBlock;
+
 	public:
 		static Core::Result<MemoryPool, AllocationError> Allocate(Device& device, MemoryTypeIndex memoryTypeIndex, size_t size);
+		// Allocates memory dedicated to the given buffer or image, of which exactly one must be non-null, with the given
+		// priority if the device supports memory priorities.
+		static Core::Result<MemoryPool, AllocationError> AllocateDedicated(Device& device, MemoryTypeIndex memoryTypeIndex, size_t size, VkBuffer buffer, VkImage image, float priority = 0.5f);
+		// Imports the given range of host memory with VK_EXT_external_memory_host, so that the device accesses it in
+		// place. The address and size must be multiples of minImportedHostPointerAlignment, and the host memory must
+		// outlive the pool. See HostMemoryImporter.
+		static Core::Result<MemoryPool, AllocationError> Import(Device& device, MemoryTypeIndex memoryTypeIndex, void* hostPointer, size_t size);
 
 
 		MemoryPool() = default;
 		MemoryPool(Device& device, MemoryTypeIndex memoryTypeIndex, VkDeviceMemory memory, size_t size);
+		// A pool with no device or device memory behind it, for driving allocators without a GPU, such as when replaying
+		// allocation traces. Blocks can be carved out of it, but it must not be mapped or bound to resources.
+		MemoryPool(MemoryTypeIndex memoryTypeIndex, size_t size);
 		MemoryPool(const MemoryPool&)            = delete;
 		MemoryPool& operator=(const MemoryPool&) = delete;
 		MemoryPool(MemoryPool&& other) noexcept;
@@ -28,27 +41,48 @@ namespace Strawberry::Vulkan
 		~MemoryPool() override;
 
 
-		MemoryBlock AllocateView(Allocator& allocator, size_t offset, size_t size);
+		// Hands out a block of this pool, returned to the given allocator on destruction, see MemoryBlock::Handle().
+		MemoryBlock AllocateView(Allocator& allocator, size_t offset, size_t size, uint32_t handle = 0);
 
 
+		bool    HasDevice() const noexcept;
 		Device& GetDevice() const noexcept;
 		VkDeviceMemory Memory() const noexcept;
 		MemoryTypeIndex GetMemoryTypeIndex() const noexcept;
 		size_t Size() const noexcept;
 
 
+		// The number of blocks handed out of this pool which are still alive, and the bytes that they cover.
+		size_t AllocatedBlockCount() const noexcept;
+		size_t AllocatedBytes() const noexcept;
+		bool   IsEmpty() const noexcept;
+
+
 		VkMemoryPropertyFlags Properties() const;
 		uint8_t*              GetMappedAddress() const noexcept;
 
 
+		// Returns the given range of this pool widened to whole multiples of nonCoherentAtomSize, as flushes and
+		// invalidations of non-coherent memory require. The range never extends past the end of the pool.
+		VkMappedMemoryRange MappedRange(size_t offset, size_t size) const noexcept;
+
+
 		void Flush() const noexcept;
 		void Overwrite(const Core::IO::DynamicByteBuffer& bytes) const noexcept;
 
 	private:
+		// Allocates device memory, with the given structure chained onto the allocation info, and the given priority if
+		// the device supports memory priorities.
+		static Core::Result<MemoryPool, AllocationError> Allocate(Device& device, MemoryTypeIndex memoryTypeIndex, size_t size, const void* next, float priority = 0.5f);
+
+
 		Core::ReflexivePointer<Device>         mDevice          = nullptr;
 		MemoryTypeIndex                        mMemoryTypeIndex = {};
 		VkDeviceMemory                         mMemory          = VK_NULL_HANDLE;
 		size_t                                 mSize            = 0;
 		mutable Core::Optional<uint8_t*>       mMappedAddress   = Core::NullOpt;
+		// Atomic, as blocks may be destroyed on any thread, see ConcurrentPolyAllocator.
+		std::atomic<size_t>                    mAllocatedBlockCount = 0;
+		std::atomic<size_t>                    mAllocatedBytes      = 0;
 	};
 }
\ No newline at end of file
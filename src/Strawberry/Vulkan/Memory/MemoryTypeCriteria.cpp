@@ -22,4 +22,10 @@ namespace Strawberry::Vulkan
 	{
 		return {.requiredProperties = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, .preferredProperties = 0};
 	}
+
+
+	MemoryTypeCriteria MemoryTypeCriteria::Transient()
+	{
+		return {.requiredProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, .preferredProperties = VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT};
+	}
 }
@@ -21,6 +21,9 @@ namespace Strawberry::Vulkan
 		static MemoryTypeCriteria Null();
 		static MemoryTypeCriteria DeviceLocal();
 		static MemoryTypeCriteria HostVisible();
+		// Device local memory for transient attachments, preferring lazily allocated memory where the device has it,
+		// which tile based GPUs may never need to back at all.
+		static MemoryTypeCriteria Transient();
 
 
 		MemoryTypeCriteria& WithMinimumSize(size_t minimumSize)
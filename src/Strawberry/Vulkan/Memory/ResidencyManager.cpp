@@ -0,0 +1,397 @@
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+#include "ResidencyManager.hpp"
+// Strawberry Vulkan
+#include "Strawberry/Vulkan/Device/Device.hpp"
+#include "Strawberry/Vulkan/Memory/DeferredReleaseQueue.hpp"
+#include "Strawberry/Vulkan/Queue/Queue.hpp"
+#include "Strawberry/Vulkan/Resource/BufferSlice.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+// Standard Library
+#include <algorithm>
+#include <array>
+#include <utility>
+
+
+//======================================================================================================================
+//  Method Definitions
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	ResidencyManager::ResidencyManager(Queue& queue, double budgetFraction, uint64_t minimumIdleFrames)
+		: mQueue(queue)
+		, mCommandPool(queue, true)
+		, mBudgetFraction(budgetFraction)
+		, mMinimumIdleFrames(std::max<uint64_t>(minimumIdleFrames, 1))
+	{}
+
+
+	ResidencyManager::~ResidencyManager()
+	{
+		ZoneScoped;
+
+		std::lock_guard lock(mMutex);
+		Submit();
+		for (const CommandBuffer& commandBuffer : mSubmissions)
+		{
+			if (commandBuffer.State() == CommandBufferState::Pending)
+			{
+				commandBuffer.Wait();
+			}
+		}
+	}
+
+
+	void ResidencyManager::Register(Buffer& buffer, float priority)
+	{
+		Core::Assert((buffer.mUsage & VK_BUFFER_USAGE_TRANSFER_SRC_BIT) && (buffer.mUsage & VK_BUFFER_USAGE_TRANSFER_DST_BIT),
+			"Buffers must be able to be copied to and from to be registered with a ResidencyManager!");
+
+		std::lock_guard lock(mMutex);
+		mEntries.insert_or_assign(&buffer, Entry{
+			.priority = priority,
+			.lastUse = mFrame,
+			.evicted = !(buffer.mMemory.Properties() & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
+		});
+	}
+
+
+	void ResidencyManager::Unregister(Buffer& buffer)
+	{
+		std::lock_guard lock(mMutex);
+		mEntries.erase(&buffer);
+		std::erase(mMoved, &buffer);
+	}
+
+
+	void ResidencyManager::SetPriority(Buffer& buffer, float priority)
+	{
+		std::lock_guard lock(mMutex);
+		mEntries.at(&buffer).priority = priority;
+	}
+
+
+	void ResidencyManager::MarkUsed(Buffer& buffer)
+	{
+		std::lock_guard lock(mMutex);
+		mEntries.at(&buffer).lastUse = mFrame;
+	}
+
+
+	bool ResidencyManager::IsResident(const Buffer& buffer) const
+	{
+		return buffer.mMemory.Properties() & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+	}
+
+
+	std::vector<Buffer*> ResidencyManager::Update()
+	{
+		ZoneScoped;
+
+		std::lock_guard lock(mMutex);
+
+		const PhysicalDevice& physicalDevice = mQueue->GetDevice().GetPhysicalDevice();
+		const auto& memoryProperties = physicalDevice.GetMemoryProperties();
+		const auto budgets = physicalDevice.GetMemoryBudget();
+		const auto usage = HeapUsage();
+
+
+		// Bring every device local heap back under its target, and note how much room each has left.
+		std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> headroom{};
+		for (uint32_t heap = 0; heap < memoryProperties.memoryHeapCount; heap++)
+		{
+			if (!(memoryProperties.memoryHeaps[heap].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT))
+			{
+				continue;
+			}
+
+			const auto target = static_cast<VkDeviceSize>(static_cast<double>(budgets[heap].budget) * mBudgetFraction);
+			if (usage[heap] > target)
+			{
+				Evict(heap, usage[heap] - target);
+			}
+			else
+			{
+				headroom[heap] = target - usage[heap];
+			}
+		}
+
+
+		// Restore the most important evicted buffers which have been used recently, for as long as there is room.
+		std::vector<std::pair<Buffer*, Entry*>> restorable;
+		for (auto& [buffer, entry] : mEntries)
+		{
+			if (entry.evicted && entry.lastUse + mMinimumIdleFrames > mFrame)
+			{
+				restorable.emplace_back(buffer, &entry);
+			}
+		}
+		std::ranges::sort(restorable, [](const auto& a, const auto& b)
+		{
+			if (a.second->priority != b.second->priority) return a.second->priority > b.second->priority;
+			return a.second->lastUse > b.second->lastUse;
+		});
+
+		const auto deviceLocalTypes = physicalDevice.SearchMemoryTypes(MemoryTypeCriteria::DeviceLocal());
+		for (auto [buffer, entry] : restorable)
+		{
+			// The heap the buffer would be restored into is that of the best device local type it can live in.
+			const VkMemoryRequirements requirements = buffer->GetMemoryRequirements(mQueue->GetDevice().Handle());
+			auto memoryType = std::ranges::find_if(deviceLocalTypes, [&](const MemoryType& type)
+			{
+				return requirements.memoryTypeBits & (1 << type.index.memoryTypeIndex);
+			});
+			if (memoryType == deviceLocalTypes.end() || requirements.size > headroom[memoryType->heapIndex])
+			{
+				continue;
+			}
+
+			if (Move(*buffer, *entry, MemoryTypeCriteria::DeviceLocal()))
+			{
+				headroom[memoryType->heapIndex] -= requirements.size;
+			}
+		}
+
+
+		Submit();
+		mFrame++;
+		return std::exchange(mMoved, {});
+	}
+
+
+	bool ResidencyManager::MakeRoom(size_t size)
+	{
+		ZoneScoped;
+
+		std::lock_guard lock(mMutex);
+		if (Evict(Core::NullOpt, size) == 0)
+		{
+			return false;
+		}
+
+		// The evicted buffers' old memory is only freed once their copies have completed.
+		Submit()->Wait();
+		mQueue->GetDevice().GetDeferredReleases().Collect();
+		return true;
+	}
+
+
+	Queue& ResidencyManager::GetQueue() const
+	{
+		return *mQueue;
+	}
+
+
+	size_t ResidencyManager::EvictedCount() const
+	{
+		std::lock_guard lock(mMutex);
+		return std::ranges::count_if(mEntries, [](const auto& entry) { return entry.second.evicted; });
+	}
+
+
+	size_t ResidencyManager::EvictedBytes() const
+	{
+		std::lock_guard lock(mMutex);
+		size_t bytes = 0;
+		for (const auto& [buffer, entry] : mEntries)
+		{
+			if (entry.evicted)
+			{
+				bytes += buffer->GetSize();
+			}
+		}
+		return bytes;
+	}
+
+
+	std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> ResidencyManager::HeapUsage()
+	{
+		Device& device = mQueue->GetDevice();
+		const auto& memoryProperties = device.GetPhysicalDevice().GetMemoryProperties();
+		const auto budgets = device.GetPhysicalDevice().GetMemoryBudget();
+
+		// Evictions whose copies have completed are freed back into the allocator's pools by collecting.
+		const uint64_t completed = device.CompletedSubmission();
+		device.GetDeferredReleases().Collect();
+		while (!mPendingEvictions.empty() && mPendingEvictions.front().submission <= completed)
+		{
+			mPendingEvictions.pop_front();
+		}
+
+		std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> usage{};
+		for (uint32_t heap = 0; heap < memoryProperties.memoryHeapCount; heap++)
+		{
+			usage[heap] = budgets[heap].usage;
+		}
+
+		// The budget only changes as whole pools are allocated and freed, so free space within them is not counted.
+		device.GetAllocator().VisitPools([&](const MemoryPool& pool, const PoolAllocator*)
+		{
+			const uint32_t heap = memoryProperties.memoryTypes[pool.GetMemoryTypeIndex().memoryTypeIndex].heapIndex;
+			usage[heap] -= std::min<VkDeviceSize>(usage[heap], pool.Size() - pool.AllocatedBytes());
+		});
+		// Nor is memory which has been evicted, but is still to be copied out of.
+		for (uint32_t heap = 0; heap < memoryProperties.memoryHeapCount; heap++)
+		{
+			usage[heap] -= std::min(usage[heap], mRecordedEvictions[heap]);
+			for (const PendingEviction& eviction : mPendingEvictions)
+			{
+				usage[heap] -= std::min(usage[heap], eviction.bytes[heap]);
+			}
+		}
+
+		return usage;
+	}
+
+
+	uint32_t ResidencyManager::HeapOf(const Buffer& buffer) const
+	{
+		const auto& memoryProperties = mQueue->GetDevice().GetPhysicalDevice().GetMemoryProperties();
+		return memoryProperties.memoryTypes[buffer.mMemory.GetMemoryPool()->GetMemoryTypeIndex().memoryTypeIndex].heapIndex;
+	}
+
+
+	size_t ResidencyManager::Evict(Core::Optional<uint32_t> heap, size_t size)
+	{
+		// Evict the least important buffers first, and the longest unused of those.
+		std::vector<std::pair<Buffer*, Entry*>> candidates;
+		for (auto& [buffer, entry] : mEntries)
+		{
+			if (!entry.evicted && entry.lastUse + mMinimumIdleFrames <= mFrame && (!heap || HeapOf(*buffer) == *heap))
+			{
+				candidates.emplace_back(buffer, &entry);
+			}
+		}
+		std::ranges::sort(candidates, [](const auto& a, const auto& b)
+		{
+			if (a.second->priority != b.second->priority) return a.second->priority < b.second->priority;
+			return a.second->lastUse < b.second->lastUse;
+		});
+
+		size_t freed = 0;
+		for (auto [buffer, entry] : candidates)
+		{
+			if (freed >= size)
+			{
+				break;
+			}
+
+			const size_t   bufferSize = buffer->mMemory.Size();
+			const uint32_t bufferHeap = HeapOf(*buffer);
+			if (!Move(*buffer, *entry, MemoryTypeCriteria::HostVisible()))
+			{
+				// Out of host memory as well, so nothing more can be evicted.
+				break;
+			}
+			freed += bufferSize;
+			mRecordedEvictions[bufferHeap] += bufferSize;
+		}
+
+		return freed;
+	}
+
+
+	bool ResidencyManager::Move(Buffer& buffer, Entry& entry, const MemoryTypeCriteria& criteria)
+	{
+		ZoneScoped;
+
+		Device& device = mQueue->GetDevice();
+		const bool toDeviceLocal = criteria.requiredProperties & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+
+		Buffer moved(device.Handle(), buffer.mSize, buffer.mUsage);
+		AllocationResult memory = device.GetAllocator().Allocate(
+			moved.GetAllocationRequest(device.Handle()).WithPriority(entry.priority), criteria);
+
+		// Host visible memory may also be device local, such as on integrated GPUs, where evicting gains nothing.
+		MemoryBlock block = memory ? memory.Unwrap() : MemoryBlock();
+		const bool isDeviceLocal = block && (block.Properties() & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+		if (!block || isDeviceLocal != toDeviceLocal)
+		{
+			// The buffer was never bound or used, so can be destroyed straight away.
+			vkDestroyBuffer(device.Handle(), std::exchange(moved.mHandle, VK_NULL_HANDLE), nullptr);
+			return false;
+		}
+
+		moved.mMemory = std::move(block);
+		Core::AssertEQ(
+			vkBindBufferMemory(device.Handle(), moved.mHandle, moved.mMemory.Memory(), moved.mMemory.Offset()),
+			VK_SUCCESS);
+		Recording().CopyBufferToBuffer(BufferSlice(buffer), BufferSlice(moved));
+
+		// The old buffer is kept until the copy out of it has been submitted, and then destroyed once it completes.
+		std::swap(buffer, moved);
+		mMovedFrom.emplace_back(std::move(moved));
+		if (std::ranges::find(mMoved, &buffer) == mMoved.end())
+		{
+			mMoved.emplace_back(&buffer);
+		}
+		entry.evicted = !toDeviceLocal;
+		return true;
+	}
+
+
+	CommandBuffer& ResidencyManager::Recording()
+	{
+		if (mRecording)
+		{
+			return *mRecording;
+		}
+
+		// Drop the command buffers of moves which have completed.
+		while (!mSubmissions.empty() && mSubmissions.front().State() != CommandBufferState::Pending)
+		{
+			mSubmissions.pop_front();
+		}
+
+		mRecording.Emplace(mCommandPool);
+		mRecording->Begin(true);
+
+		// Wait for all prior use of the buffers before copying them.
+		mRecording->PipelineBarrier(
+			VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			0,
+			{
+				VkMemoryBarrier{
+					.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+					.pNext = nullptr,
+					.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT,
+					.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT
+				}
+			});
+		return *mRecording;
+	}
+
+
+	CommandBuffer* ResidencyManager::Submit()
+	{
+		if (!mRecording)
+		{
+			return nullptr;
+		}
+
+		// The queue keeps a pointer to the command buffer, so it is put where it will stay before it is submitted.
+		CommandBuffer& commandBuffer = mSubmissions.emplace_back(mRecording.Unwrap());
+		commandBuffer.PipelineBarrier(
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+			0,
+			{
+				VkMemoryBarrier{
+					.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+					.pNext = nullptr,
+					.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+					.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT
+				}
+			});
+		commandBuffer.End();
+		const uint64_t submission = mQueue->Submit(commandBuffer);
+		mPendingEvictions.emplace_back(PendingEviction{.submission = submission, .bytes = std::exchange(mRecordedEvictions, {})});
+
+		// Released now, the old buffers are tagged with the submission which copies out of them.
+		mMovedFrom.clear();
+		return &commandBuffer;
+	}
+}
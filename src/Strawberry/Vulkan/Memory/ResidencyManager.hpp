@@ -0,0 +1,148 @@
+#pragma once
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+// Strawberry Vulkan
+#include "Strawberry/Vulkan/Queue/CommandBuffer.hpp"
+#include "Strawberry/Vulkan/Queue/CommandPool.hpp"
+#include "Strawberry/Vulkan/Resource/Buffer.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Types/Optional.hpp"
+#include "Strawberry/Core/Types/ReflexivePointer.hpp"
+// Vulkan
+#include <vulkan/vulkan.h>
+// Standard Library
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+
+//======================================================================================================================
+//  Class Declaration
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	class Queue;
+
+
+	// Keeps the most important buffers in device local memory when there is not enough of it for all of them.
+	//
+	// Registered buffers are given a priority, and are marked each frame that they are used. When a device local heap
+	// goes over its budget, see PhysicalDevice::GetMemoryBudget(), the buffers which have gone unused the longest, and
+	// are least important, are evicted: their contents are copied into host visible memory, which the device can still
+	// read from, only more slowly. Evicted buffers which are used again are restored to device local memory once there
+	// is room. Buffer::Builder::Build() also evicts buffers through MakeRoom() when device local memory runs out.
+	//
+	// Like the Defragmenter, moving a buffer gives it a new handle bound to its new memory, so descriptor sets which
+	// refer to moved buffers must be rewritten. Only buffers which have gone unused for a few frames are evicted, and
+	// buffers are only restored by Update(), which must be called after the frame's work has been submitted. Copies
+	// are submitted to the manager's queue, see GetQueue(), and are only ordered against other work submitted to that
+	// same queue, so registered buffers must only be used on it. They must also have both transfer source and
+	// destination usage.
+	//
+	// Every device has one of these, see Device::GetResidencyManager(). Registered buffers must stay at the same address
+	// until they are unregistered. The manager is thread safe.
+	class ResidencyManager
+	{
+	public:
+		explicit ResidencyManager(Queue& queue, double budgetFraction = 0.9, uint64_t minimumIdleFrames = 2);
+		ResidencyManager(const ResidencyManager&)            = delete;
+		ResidencyManager& operator=(const ResidencyManager&) = delete;
+		~ResidencyManager();
+
+
+		// Starts tracking the given buffer. Buffers which are not in device local memory, for example because they were
+		// built while it had run out, count as evicted, and are moved into it once they are used and there is room.
+		void Register(Buffer& buffer, float priority = 0.5f);
+		void Unregister(Buffer& buffer);
+		// Sets how important it is that the buffer stays in device local memory, from 0 to 1.
+		void SetPriority(Buffer& buffer, float priority);
+
+
+		// Marks the buffer as used in the current frame. Evicted buffers are restored by the next Update().
+		void MarkUsed(Buffer& buffer);
+		// Returns whether the buffer is in device local memory.
+		[[nodiscard]] bool IsResident(const Buffer& buffer) const;
+
+
+		// Ends the current frame. Evicts cold buffers from heaps over budget, and restores evicted buffers which were used
+		// recently while there is room for them. Returns every buffer moved since the last call, including those moved
+		// by MakeRoom(), whose descriptor sets must be rewritten.
+		std::vector<Buffer*> Update();
+
+		// Evicts cold buffers until at least the given number of bytes of device local memory has been freed, waiting
+		// for the copies to complete. Returns whether anything was evicted.
+		bool MakeRoom(size_t size);
+
+
+		// Returns the queue which copies are submitted to, and which registered buffers must be used on.
+		[[nodiscard]] Queue& GetQueue() const;
+
+
+		// Returns the number of registered buffers which are evicted, and the bytes they cover.
+		[[nodiscard]] size_t EvictedCount() const;
+		[[nodiscard]] size_t EvictedBytes() const;
+
+
+	private:
+		struct Entry
+		{
+			float    priority;
+			// The frame in which the buffer was last used.
+			uint64_t lastUse;
+			bool     evicted;
+		};
+
+
+		// Evictions submitted together, and the bytes they free from each heap once their copies complete.
+		struct PendingEviction
+		{
+			uint64_t                                      submission;
+			std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> bytes;
+		};
+
+
+		// Returns how much of each heap is in use, which unlike the budget's usage goes down as soon as buffers are
+		// evicted from it. Collects deferred releases.
+		std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> HeapUsage();
+		// Returns the heap which the buffer's memory is in.
+		uint32_t HeapOf(const Buffer& buffer) const;
+		// Evicts cold resident buffers in the given heap, or any device local heap if none is given, until at least the
+		// given number of bytes have been freed. Returns the number of bytes freed.
+		size_t Evict(Core::Optional<uint32_t> heap, size_t size);
+		// Moves the buffer into memory meeting the given criteria, recording the copy. Fails if there is no room, or if
+		// the memory it would move to is no different.
+		bool Move(Buffer& buffer, Entry& entry, const MemoryTypeCriteria& criteria);
+		// Returns the command buffer which moves are being recorded into, beginning one if need be.
+		CommandBuffer& Recording();
+		// Submits the moves recorded so far, returning the command buffer they were submitted in, or null if there were
+		// none.
+		CommandBuffer* Submit();
+
+
+		Core::ReflexivePointer<Queue>       mQueue;
+		CommandPool                         mCommandPool;
+		double                              mBudgetFraction;
+		uint64_t                            mMinimumIdleFrames;
+
+		uint64_t                            mFrame = 0;
+		std::unordered_map<Buffer*, Entry>  mEntries;
+		// Buffers moved since the last Update().
+		std::vector<Buffer*>                mMoved;
+		// The old buffers of moves which have been recorded, kept until their copies are submitted.
+		std::vector<Buffer>                 mMovedFrom;
+		// The bytes evicted from each heap by moves which have been recorded, and by those which have been submitted
+		// but may not have completed, oldest first.
+		std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> mRecordedEvictions{};
+		std::deque<PendingEviction>         mPendingEvictions;
+
+		Core::Optional<CommandBuffer>       mRecording;
+		// Submitted command buffers which may not have completed, oldest first.
+		std::deque<CommandBuffer>           mSubmissions;
+
+		mutable std::mutex                  mMutex;
+	};
+}
@@ -23,7 +23,8 @@ namespace Strawberry::Vulkan
 	GraphicsPipeline::GraphicsPipeline(GraphicsPipeline&& rhs) noexcept
 		: mPipeline(std::exchange(rhs.mPipeline, nullptr))
 		, mPipelineLayout(std::exchange(rhs.mPipelineLayout, nullptr))
-		, mRenderPass(std::move(rhs.mRenderPass)) {}
+		, mRenderPass(std::move(rhs.mRenderPass))
+		, mVertexInputBindings(std::move(rhs.mVertexInputBindings)) {}
 
 
 	GraphicsPipeline& GraphicsPipeline::operator=(GraphicsPipeline&& rhs) noexcept
@@ -59,6 +60,16 @@ namespace Strawberry::Vulkan
 	}
 
 
+	Core::Optional<VkVertexInputBindingDescription> GraphicsPipeline::GetVertexInputBinding(uint32_t binding) const noexcept
+	{
+		for (const VkVertexInputBindingDescription& description : mVertexInputBindings)
+		{
+			if (description.binding == binding) return description;
+		}
+		return Core::NullOpt;
+	}
+
+
 	GraphicsPipeline::Builder::Builder(PipelineLayout& layout, RenderPass& renderPass, uint32_t subpass)
 		: mRenderPass(renderPass)
 		  , mSubpass(subpass)
@@ -347,10 +358,12 @@ namespace Strawberry::Vulkan
 	}
 
 
-	GraphicsPipeline::GraphicsPipeline(VkPipeline handle, PipelineLayout& layout, RenderPass& renderPass)
+	GraphicsPipeline::GraphicsPipeline(VkPipeline handle, PipelineLayout& layout, RenderPass& renderPass,
+	                                   std::vector<VkVertexInputBindingDescription> vertexInputBindings)
 		: mPipeline(handle)
 		  , mPipelineLayout(layout)
-		  , mRenderPass(renderPass) {}
+		  , mRenderPass(renderPass)
+		  , mVertexInputBindings(std::move(vertexInputBindings)) {}
 
 
 	GraphicsPipeline GraphicsPipeline::Builder::Build()
@@ -483,6 +496,6 @@ namespace Strawberry::Vulkan
 												 &handle),
 					   VK_SUCCESS);
 
-		return GraphicsPipeline(handle, *mPipelineLayout, *mRenderPass);
+		return GraphicsPipeline(handle, *mPipelineLayout, *mRenderPass, mVertexInputBindings);
 	}
 }
@@ -55,8 +55,13 @@ namespace Strawberry::Vulkan
 		Result<DescriptorSet>         CreateDescriptorSet(unsigned int);
 
 
+		// Returns the description of the given vertex input binding, if the pipeline has one.
+		Core::Optional<VkVertexInputBindingDescription> GetVertexInputBinding(uint32_t binding) const noexcept;
+
+
 	private:
-		GraphicsPipeline(VkPipeline handle, PipelineLayout& layout, RenderPass& renderPass);
+		GraphicsPipeline(VkPipeline handle, PipelineLayout& layout, RenderPass& renderPass,
+		                 std::vector<VkVertexInputBindingDescription> vertexInputBindings);
 
 
 	private:
@@ -66,6 +71,8 @@ namespace Strawberry::Vulkan
 		Core::ReflexivePointer<PipelineLayout> mPipelineLayout;
 		// Our RenderPass
 		Core::ReflexivePointer<RenderPass> mRenderPass;
+		// The vertex input bindings the pipeline was built with
+		std::vector<VkVertexInputBindingDescription> mVertexInputBindings;
 	};
 
 
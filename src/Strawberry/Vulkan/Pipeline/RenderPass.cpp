@@ -21,7 +21,12 @@ namespace Strawberry::Vulkan
 		: mRenderPass(std::exchange(rhs.mRenderPass, nullptr))
 		, mDevice(std::move(rhs.mDevice))
 		, mAttachmentFormats(std::move(rhs.mAttachmentFormats))
-		, mClearColors(std::move(rhs.mClearColors)) {}
+		, mAttachmentUsages(std::move(rhs.mAttachmentUsages))
+		, mClearColors(std::move(rhs.mClearColors))
+		, mAttachmentAspectFlags(std::move(rhs.mAttachmentAspectFlags))
+		, mInitialLayouts(std::move(rhs.mInitialLayouts))
+		, mTransientSlots(std::move(rhs.mTransientSlots))
+		, mTransientSlotCount(std::exchange(rhs.mTransientSlotCount, 0)) {}
 
 
 	RenderPass& RenderPass::operator=(RenderPass&& rhs) noexcept
@@ -57,6 +62,24 @@ namespace Strawberry::Vulkan
 	}
 
 
+	bool RenderPass::IsTransientAttachment(uint32_t index) const
+	{
+		return mTransientSlots[index].HasValue();
+	}
+
+
+	uint32_t RenderPass::GetTransientSlot(uint32_t index) const
+	{
+		return mTransientSlots[index].Value();
+	}
+
+
+	uint32_t RenderPass::GetTransientSlotCount() const
+	{
+		return mTransientSlotCount;
+	}
+
+
 	SubpassDescription& SubpassDescription::WithInputAttachment(uint32_t index, VkImageLayout layout)
 	{
 		mInputAttachments.emplace_back(VkAttachmentReference{
@@ -273,6 +296,22 @@ namespace Strawberry::Vulkan
 			std::ranges::to<std::vector>();
 
 
+		renderPass.mTransientSlots.resize(mAttachments.size());
+		renderPass.mTransientSlotCount = AssignTransientSlots(renderPass.mTransientSlots);
+
+		// Attachments sharing a slot share memory within the render pass, which Vulkan must be told about.
+		for (uint32_t i = 0; i < mAttachments.size(); i++)
+		{
+			if (!renderPass.mTransientSlots[i]) continue;
+
+			const auto sharesSlot = [&](const Core::Optional<uint32_t>& slot) { return slot && *slot == *renderPass.mTransientSlots[i]; };
+			if (std::ranges::count_if(renderPass.mTransientSlots, sharesSlot) > 1)
+			{
+				attachmentDescriptions[i].flags |= VK_ATTACHMENT_DESCRIPTION_MAY_ALIAS_BIT;
+			}
+		}
+
+
 		VkRenderPassCreateInfo renderPassCreateInfo{
 			.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
 			.pNext = nullptr,
@@ -290,4 +329,93 @@ namespace Strawberry::Vulkan
 
 		return renderPass;
 	}
+
+
+	bool RenderPass::Builder::IsTransient(uint32_t attachment) const
+	{
+		static constexpr VkImageUsageFlags ATTACHMENT_USAGES =
+			VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT
+			| VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT
+			| VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT
+			| VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+
+		const Attachment& description = mAttachments[attachment];
+		return description.description.loadOp != VK_ATTACHMENT_LOAD_OP_LOAD
+			&& description.description.storeOp == VK_ATTACHMENT_STORE_OP_DONT_CARE
+			&& description.description.stencilLoadOp != VK_ATTACHMENT_LOAD_OP_LOAD
+			&& description.description.stencilStoreOp == VK_ATTACHMENT_STORE_OP_DONT_CARE
+			&& description.description.initialLayout == VK_IMAGE_LAYOUT_UNDEFINED
+			&& (description.usage & ~ATTACHMENT_USAGES) == 0;
+	}
+
+
+	uint32_t RenderPass::Builder::AssignTransientSlots(std::vector<Core::Optional<uint32_t>>& slots) const
+	{
+		struct Lifetime
+		{
+			uint32_t attachment;
+			uint32_t firstSubpass;
+			uint32_t lastSubpass;
+		};
+
+
+		// Find the range of subpasses in which each attachment is used.
+		std::vector<Core::Optional<Lifetime>> lifetimes(mAttachments.size());
+		const auto use = [&](uint32_t subpass, const VkAttachmentReference& reference)
+		{
+			if (reference.attachment == VK_ATTACHMENT_UNUSED) return;
+
+			Core::Optional<Lifetime>& lifetime = lifetimes[reference.attachment];
+			if (!lifetime) lifetime = Lifetime{reference.attachment, subpass, subpass};
+			lifetime->lastSubpass = subpass;
+		};
+		for (uint32_t subpass = 0; subpass < mSubpasses.size(); subpass++)
+		{
+			for (const VkAttachmentReference& reference : mSubpasses[subpass].mInputAttachments) use(subpass, reference);
+			for (const VkAttachmentReference& reference : mSubpasses[subpass].mColorAttachments) use(subpass, reference);
+			if (mSubpasses[subpass].mDepthStencilAttachment) use(subpass, *mSubpasses[subpass].mDepthStencilAttachment);
+		}
+
+
+		std::vector<Lifetime> transients;
+		for (uint32_t attachment = 0; attachment < mAttachments.size(); attachment++)
+		{
+			if (lifetimes[attachment] && IsTransient(attachment))
+			{
+				transients.emplace_back(*lifetimes[attachment]);
+			}
+		}
+		std::ranges::stable_sort(transients, {}, &Lifetime::firstSubpass);
+
+
+		// Attachments can only follow one another in memory if every use of the first is finished before the second
+		// is first used, which needs a dependency between the subpasses using them.
+		const auto canFollow = [&](const Lifetime& before, const Lifetime& after)
+		{
+			return before.lastSubpass < after.firstSubpass && std::ranges::any_of(mDependencies, [&](const VkSubpassDependency& dependency)
+			{
+				return dependency.srcSubpass != VK_SUBPASS_EXTERNAL && dependency.dstSubpass != VK_SUBPASS_EXTERNAL
+					&& before.lastSubpass <= dependency.srcSubpass && dependency.srcSubpass < dependency.dstSubpass
+					&& dependency.dstSubpass <= after.firstSubpass;
+			});
+		};
+
+
+		// Greedily place each attachment, in order of first use, after the last attachment of the first slot that it
+		// can follow.
+		std::vector<Lifetime> slotTails;
+		for (const Lifetime& lifetime : transients)
+		{
+			auto slot = std::ranges::find_if(slotTails, [&](const Lifetime& tail) { return canFollow(tail, lifetime); });
+			if (slot == slotTails.end())
+			{
+				slot = slotTails.insert(slotTails.end(), lifetime);
+			}
+
+			*slot = lifetime;
+			slots[lifetime.attachment] = static_cast<uint32_t>(std::distance(slotTails.begin(), slot));
+		}
+
+		return static_cast<uint32_t>(slotTails.size());
+	}
 }
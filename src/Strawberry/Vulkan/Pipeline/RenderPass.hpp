@@ -46,6 +46,17 @@ namespace Strawberry::Vulkan
 
 		Device& GetDevice();
 
+
+		// Returns whether the contents of the given attachment never leave the render pass, so that framebuffers can
+		// create it as a transient attachment in lazily allocated memory. These are attachments which are neither
+		// loaded nor stored, start in an undefined layout, and are only used as attachments.
+		[[nodiscard]] bool IsTransientAttachment(uint32_t index) const;
+		// Returns the memory slot which the given transient attachment is placed in. Transient attachments which share
+		// a slot are never used at the same time, and may share memory. See TransientAttachmentPool.
+		[[nodiscard]] uint32_t GetTransientSlot(uint32_t index) const;
+		// Returns the number of memory slots that the transient attachments of this render pass need.
+		[[nodiscard]] uint32_t GetTransientSlotCount() const;
+
 	protected:
 		RenderPass(Device& device);
 
@@ -58,6 +69,9 @@ namespace Strawberry::Vulkan
 		std::vector<VkClearValue>       mClearColors;
 		std::vector<VkImageAspectFlags> mAttachmentAspectFlags;
 		std::vector<VkImageLayout>      mInitialLayouts;
+		// The memory slot of each attachment, or nothing for attachments which are not transient.
+		std::vector<Core::Optional<uint32_t>> mTransientSlots;
+		uint32_t                              mTransientSlotCount = 0;
 	};
 
 
@@ -131,6 +145,13 @@ namespace Strawberry::Vulkan
 		[[nodiscard]] RenderPass Build();
 
 	private:
+		// Returns whether the given attachment's contents never leave the render pass.
+		bool IsTransient(uint32_t attachment) const;
+		// Places each transient attachment into a memory slot, sharing slots between attachments which are used in
+		// subpasses ordered by a dependency, and returns the number of slots.
+		uint32_t AssignTransientSlots(std::vector<Core::Optional<uint32_t>>& slots) const;
+
+
 		Core::ReflexivePointer<Device> mDevice;
 
 
@@ -1,7 +1,9 @@
 #pragma once
 #include "Strawberry/Vulkan/Resource/Buffer.hpp"
+#include "Strawberry/Vulkan/Resource/BufferSlice.hpp"
 #include "Strawberry/Core/Types/ValOrPtr.hpp"
 #include <map>
+#include <vector>
 
 
 namespace Strawberry::Vulkan
@@ -38,8 +40,8 @@ namespace Strawberry::Vulkan
 			bool operator==(const IndexBuffer&) const = default;
 			bool operator!=(const IndexBuffer&) const = default;
 
-			VkIndexType            type;
-			Core::ValOrPtr<Buffer> buffer;
+			VkIndexType type;
+			BufferSlice slice;
 		};
 
 		struct PushConstant
@@ -74,13 +76,30 @@ namespace Strawberry::Vulkan
 
 		Batch&& WithVertexBuffer(unsigned int index, Core::ValOrPtr<Buffer> buffer)
 		{
-			mVertexBuffers.emplace(index, std::move(buffer));
+			mVertexBuffers.emplace(index, BufferSlice(buffer.Resolve()));
+			mHeldBuffers.emplace_back(std::move(buffer));
+			return std::move(*this);
+		}
+
+		/// Consecutive batches whose slices start a whole number of vertices further into the same buffer are drawn
+		/// through the draw's vertex offset, without rebinding the buffer, see BufferArena.
+		Batch&& WithVertexBuffer(unsigned int index, BufferSlice slice)
+		{
+			mVertexBuffers.emplace(index, slice);
 			return std::move(*this);
 		}
 
 		Batch&& WithIndexBuffer(VkIndexType type, Core::ValOrPtr<Buffer> buffer)
 		{
-			mIndexBuffer.Emplace(type, std::move(buffer));
+			mIndexBuffer.Emplace(type, BufferSlice(buffer.Resolve()));
+			mHeldBuffers.emplace_back(std::move(buffer));
+			return std::move(*this);
+		}
+
+		/// Likewise, slices further into the same index buffer are drawn through the draw's first index.
+		Batch&& WithIndexBuffer(VkIndexType type, BufferSlice slice)
+		{
+			mIndexBuffer.Emplace(type, slice);
 			return std::move(*this);
 		}
 
@@ -111,9 +130,11 @@ namespace Strawberry::Vulkan
 		/// Descriptor sets to use to to render batch
 		std::map<unsigned int, Core::ValOrPtr<DescriptorSet>> mDescriptorSets;
 		/// Vertex Buffers used to render batch
-		std::map<unsigned int, Core::ValOrPtr<Buffer>> mVertexBuffers;
+		std::map<unsigned int, BufferSlice> mVertexBuffers;
 		/// Potential Index Buffer to use render batch
 		Core::Optional<IndexBuffer> mIndexBuffer;
+		/// Buffers given to the batch, which it keeps alive if it owns them
+		std::vector<Core::ValOrPtr<Buffer>> mHeldBuffers;
 		/// A set of push constants
 		std::map<unsigned int, PushConstant> mPushConstants;
 
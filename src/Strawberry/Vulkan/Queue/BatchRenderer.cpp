@@ -1,6 +1,9 @@
 #include "Strawberry/Vulkan/Queue/BatchRenderer.hpp"
 
 #include "CommandBuffer.hpp"
+#include "Strawberry/Vulkan/Pipeline/GraphicsPipeline.hpp"
+#include "Strawberry/Core/Assert.hpp"
+#include <limits>
 
 
 namespace Strawberry::Vulkan
@@ -15,17 +18,18 @@ namespace Strawberry::Vulkan
 	{
 		std::ranges::sort(mBatches, {}, [] (const auto& x) { return x.mOrderingConstant; });
 		Core::Optional<const Batch*> lastBatch;
+		BoundState bound;
 		for (const auto& batch : mBatches)
 		{
-			ApplyBatchTransition(buffer, batch, lastBatch);
+			const DrawOffsets offsets = ApplyBatchTransition(buffer, batch, lastBatch, bound);
 
 			if (batch.mIndexBuffer)
 			{
-				buffer.DrawIndexed(batch.mVertexCount, batch.mInstanceCount, batch.mFirstVertex, batch.mFirstInstance);
+				buffer.DrawIndexed(batch.mVertexCount, batch.mInstanceCount, batch.mFirstVertex + offsets.firstIndex, batch.mFirstInstance, static_cast<int32_t>(offsets.vertexOffset));
 			}
 			else
 			{
-				buffer.Draw(batch.mVertexCount, batch.mInstanceCount, batch.mFirstVertex, batch.mFirstInstance);
+				buffer.Draw(batch.mVertexCount, batch.mInstanceCount, batch.mFirstVertex + offsets.vertexOffset, batch.mFirstInstance);
 			}
 
 			lastBatch = &batch;
@@ -39,8 +43,10 @@ namespace Strawberry::Vulkan
 	}
 
 
-	void BatchRenderer::ApplyBatchTransition(CommandBuffer& buffer, const Batch& batch, const Core::Optional<const Batch*>& lastBatch)
+	BatchRenderer::DrawOffsets BatchRenderer::ApplyBatchTransition(CommandBuffer& buffer, const Batch& batch, const Core::Optional<const Batch*>& lastBatch, BoundState& bound)
 	{
+		DrawOffsets offsets;
+
 		if (batch.mGraphicsPipeline != lastBatch.Map([] (const auto& x) { return x->mGraphicsPipeline; } ))
 		{
 			buffer.BindPipeline(*batch.mGraphicsPipeline);
@@ -55,22 +61,103 @@ namespace Strawberry::Vulkan
 			}
 		}
 
-		for (const auto& [index, vertexBuffer] : batch.mVertexBuffers)
+		// Slices further into the buffers which are already bound are reached through the draw's vertex offset instead.
+		if (auto vertexOffset = GetVertexOffset(batch, bound))
 		{
-			if (!lastBatch.HasValue() || (!lastBatch->mVertexBuffers.contains(index) || vertexBuffer != lastBatch->mVertexBuffers.at(index)))
+			offsets.vertexOffset = vertexOffset.Value();
+		}
+		else
+		{
+			for (const auto& [index, vertexBuffer] : batch.mVertexBuffers)
 			{
-				buffer.BindVertexBuffer(index, vertexBuffer.Resolve());
+				auto boundBuffer = bound.vertexBuffers.find(index);
+				if (boundBuffer == bound.vertexBuffers.end() || boundBuffer->second != vertexBuffer)
+				{
+					buffer.BindVertexBuffer(index, vertexBuffer);
+					bound.vertexBuffers.insert_or_assign(index, vertexBuffer);
+				}
 			}
 		}
 
-		if (batch.mIndexBuffer && (!lastBatch.HasValue() || lastBatch->mIndexBuffer != batch.mIndexBuffer))
+		if (batch.mIndexBuffer)
 		{
-			buffer.BindIndexBuffer(batch.mIndexBuffer->buffer.Resolve(), batch.mIndexBuffer->type, 0);
+			const Batch::IndexBuffer& indexBuffer = batch.mIndexBuffer.Value();
+
+			VkDeviceSize indexSize = 0;
+			switch (indexBuffer.type)
+			{
+				case VK_INDEX_TYPE_UINT16:    indexSize = 2; break;
+				case VK_INDEX_TYPE_UINT32:    indexSize = 4; break;
+				case VK_INDEX_TYPE_UINT8_EXT: indexSize = 1; break;
+				default: Core::Unreachable();
+			}
+
+			// Likewise, slices further into the bound index buffer are reached through the draw's first index.
+			const bool sameBuffer = bound.indexBuffer
+				&& bound.indexBuffer->type == indexBuffer.type
+				&& bound.indexBuffer->slice.buffer == indexBuffer.slice.buffer
+				&& bound.indexBuffer->slice.offset <= indexBuffer.slice.offset;
+			const VkDeviceSize delta = sameBuffer ? indexBuffer.slice.offset - bound.indexBuffer->slice.offset : 0;
+			if (sameBuffer && delta % indexSize == 0 && delta / indexSize <= std::numeric_limits<uint32_t>::max())
+			{
+				offsets.firstIndex = static_cast<uint32_t>(delta / indexSize);
+			}
+			else
+			{
+				buffer.BindIndexBuffer(indexBuffer.slice, indexBuffer.type);
+				bound.indexBuffer.Emplace(indexBuffer);
+			}
 		}
 
 		for (const auto& [index, pushContant] : batch.mPushConstants)
 		{
 			buffer.PushConstants(*batch.mGraphicsPipeline, pushContant.pipelineStages, pushContant.bytes, 0);
 		}
+
+		return offsets;
+	}
+
+
+	Core::Optional<uint32_t> BatchRenderer::GetVertexOffset(const Batch& batch, const BoundState& bound)
+	{
+		Core::Optional<uint32_t> vertexOffset;
+		for (const auto& [index, vertexBuffer] : batch.mVertexBuffers)
+		{
+			auto boundBuffer = bound.vertexBuffers.find(index);
+			if (boundBuffer == bound.vertexBuffers.end()
+				|| boundBuffer->second.buffer != vertexBuffer.buffer
+				|| boundBuffer->second.offset > vertexBuffer.offset)
+			{
+				return Core::NullOpt;
+			}
+
+			const VkDeviceSize delta = vertexBuffer.offset - boundBuffer->second.offset;
+			const auto binding = batch.mGraphicsPipeline->GetVertexInputBinding(index);
+			// Per instance bindings are not moved by the vertex offset, so must already be bound where they start.
+			if (!binding || binding->inputRate != VK_VERTEX_INPUT_RATE_VERTEX || binding->stride == 0)
+			{
+				if (delta != 0) return Core::NullOpt;
+				continue;
+			}
+
+			if (delta % binding->stride != 0 || delta / binding->stride > std::numeric_limits<int32_t>::max())
+			{
+				return Core::NullOpt;
+			}
+
+			const auto vertices = static_cast<uint32_t>(delta / binding->stride);
+			if (vertexOffset && vertexOffset.Value() != vertices)
+			{
+				return Core::NullOpt;
+			}
+			vertexOffset = vertices;
+		}
+
+		// Batches without any per vertex bindings need no offset at all.
+		if (!vertexOffset)
+		{
+			vertexOffset = 0u;
+		}
+		return vertexOffset;
 	}
 }
@@ -1,7 +1,9 @@
 #pragma once
 // Includes
 #include "Strawberry/Vulkan/Queue/Batch.hpp"
+#include <cstdint>
 #include <deque>
+#include <map>
 
 namespace Strawberry::Vulkan
 {
@@ -28,7 +30,28 @@ namespace Strawberry::Vulkan
 
 
 	private:
-		static void ApplyBatchTransition(CommandBuffer& buffer, const Batch& batch, const Core::Optional<const Batch*>& lastBatch);
+		// What is bound to the command buffer being written, so that batches whose slices start further into the same
+		// buffers can be drawn without rebinding them.
+		struct BoundState
+		{
+			std::map<unsigned int, BufferSlice> vertexBuffers;
+			Core::Optional<Batch::IndexBuffer>  indexBuffer;
+		};
+
+
+		// Where to start drawing a batch within the bound buffers, in vertices and indices.
+		struct DrawOffsets
+		{
+			uint32_t vertexOffset = 0;
+			uint32_t firstIndex   = 0;
+		};
+
+
+		static DrawOffsets ApplyBatchTransition(CommandBuffer& buffer, const Batch& batch, const Core::Optional<const Batch*>& lastBatch, BoundState& bound);
+
+		// Returns how many vertices further into the bound buffers each of the batch's vertex slices starts, if they
+		// all start the same whole number of vertices further in.
+		static Core::Optional<uint32_t> GetVertexOffset(const Batch& batch, const BoundState& bound);
 
 
 		std::deque<Batch> mBatches;
@@ -52,11 +52,14 @@ namespace Strawberry::Vulkan
 
 
 	CommandBuffer::CommandBuffer(CommandBuffer&& rhs) noexcept
-		: mCommandBuffer(std::exchange(rhs.mCommandBuffer, nullptr))
+		// Pointers to submitted command buffers, such as those the queue keeps, follow them when they are moved.
+		: EnableReflexivePointer(std::move(rhs))
+		  , mCommandBuffer(std::exchange(rhs.mCommandBuffer, nullptr))
 		  , mCommandPool(std::move(rhs.mCommandPool))
 		  , mState(std::exchange(rhs.mState, CommandBufferState::Invalid))
 		  , mOneTimeSubmission(rhs.mOneTimeSubmission)
 		  , mExecutionFenceOrParentBuffer(std::move(rhs.mExecutionFenceOrParentBuffer))
+		  , mBatchFence(std::move(rhs.mBatchFence))
 		  , mRecordedSecondaryBuffers(std::move(rhs.mRecordedSecondaryBuffers)) {}
 
 
@@ -98,6 +101,15 @@ namespace Strawberry::Vulkan
 	{
 		ZoneScoped;
 
+		if (mBatchFence)
+		{
+			if (!mBatchFence->Signaled())
+			{
+				mBatchFence->fence->Wait();
+			}
+			return;
+		}
+
 		return mExecutionFenceOrParentBuffer.Ptr<Fence>()->Wait();
 	}
 
@@ -116,7 +128,11 @@ namespace Strawberry::Vulkan
 			// If we own the fence we can check it normally.
 			if (IsExecutionFenceSignalled())
 			{
-				mExecutionFenceOrParentBuffer.Ptr<Fence>()->Reset();
+				// Batch fences may be watched by other command buffers, so are only reset when they are next submitted.
+				if (!mBatchFence)
+				{
+					mExecutionFenceOrParentBuffer.Ptr<Fence>()->Reset();
+				}
 				MoveIntoCompletedState();
 			}
 		}
@@ -291,17 +307,28 @@ namespace Strawberry::Vulkan
 
 
 	void CommandBuffer::BindVertexBuffer(uint32_t binding, const Buffer& buffer, VkDeviceSize offset)
+	{
+		BindVertexBuffer(binding, BufferSlice(buffer, offset, buffer.GetSize() - offset));
+	}
+
+
+	void CommandBuffer::BindVertexBuffer(uint32_t binding, const BufferSlice& slice)
 	{
 		Core::Assert(State() == CommandBufferState::Recording);
-		VkBuffer handle = buffer;
-		vkCmdBindVertexBuffers(mCommandBuffer, binding, 1, &handle, &offset);
+		vkCmdBindVertexBuffers(mCommandBuffer, binding, 1, &slice.buffer, &slice.offset);
 	}
 
 
 	void CommandBuffer::BindIndexBuffer(const Buffer& buffer, VkIndexType indexType, uint32_t offset)
+	{
+		BindIndexBuffer(BufferSlice(buffer, offset, buffer.GetSize() - offset), indexType);
+	}
+
+
+	void CommandBuffer::BindIndexBuffer(const BufferSlice& slice, VkIndexType indexType)
 	{
 		Core::Assert(State() == CommandBufferState::Recording);
-		vkCmdBindIndexBuffer(mCommandBuffer, buffer, offset, indexType);
+		vkCmdBindIndexBuffer(mCommandBuffer, slice.buffer, slice.offset, indexType);
 	}
 
 
@@ -338,6 +365,10 @@ namespace Strawberry::Vulkan
 			{
 				imageBarriers.emplace_back(barrier.Ref<ImageMemoryBarrier>());
 			}
+			else if (barrier.IsType<VkMemoryBarrier>())
+			{
+				memoryBarriers.emplace_back(barrier.Ref<VkMemoryBarrier>());
+			}
 			else [[unlikely]]
 			{
 				Core::Unreachable();
@@ -381,7 +412,7 @@ namespace Strawberry::Vulkan
 			.layerCount = 1,
 		};
 		VkBufferImageCopy region{
-			.bufferOffset = 0,
+			.bufferOffset = command.mSrcBuffer->offset,
 			.bufferRowLength = 0,
 			.bufferImageHeight = 0,
 			.imageSubresource = subresource,
@@ -390,7 +421,7 @@ namespace Strawberry::Vulkan
 		};
 		vkCmdCopyBufferToImage(
 			mCommandBuffer,
-			*command.mSrcBuffer,
+			command.mSrcBuffer->buffer,
 			*command.mDstImage,
 			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
 			1,
@@ -398,6 +429,20 @@ namespace Strawberry::Vulkan
 	}
 
 
+	void CommandBuffer::CopyBufferToBuffer(const BufferSlice& source, const BufferSlice& destination)
+	{
+		Core::Assert(State() == CommandBufferState::Recording);
+		Core::Assert(source.size <= destination.size);
+
+		const VkBufferCopy region{
+			.srcOffset = source.offset,
+			.dstOffset = destination.offset,
+			.size = source.size,
+		};
+		vkCmdCopyBuffer(mCommandBuffer, source.buffer, destination.buffer, 1, &region);
+	}
+
+
 	void CommandBuffer::CopyImageToImage(const Image&  source, VkImageLayout          srcLayout, const Image& dest,
 										 VkImageLayout destLayout, VkImageAspectFlags aspect)
 	{
@@ -718,7 +763,11 @@ namespace Strawberry::Vulkan
 
 	bool CommandBuffer::IsExecutionFenceSignalled() const noexcept
 	{
-		if (auto fence = mExecutionFenceOrParentBuffer.Ptr<Fence>())
+		if (mBatchFence)
+		{
+			return mBatchFence->Signaled();
+		}
+		else if (auto fence = mExecutionFenceOrParentBuffer.Ptr<Fence>())
 		{
 			return fence->Signaled();
 		}
@@ -731,4 +780,11 @@ namespace Strawberry::Vulkan
 			Core::Unreachable();
 		}
 	}
+
+
+	bool CommandBuffer::BatchFence::Signaled() const noexcept
+	{
+		// A batch fence which has since been destroyed or reset can only have been so after the batch completed.
+		return !fence || fence->ResetCount() != resetCount || fence->Signaled();
+	}
 }
@@ -6,6 +6,7 @@
 //----------------------------------------------------------------------------------------------------------------------
 #include "Strawberry/Vulkan/Queue/CommandParameters.hpp"
 #include "Strawberry/Vulkan/Queue/ImageMemoryBarrier.hpp"
+#include "Strawberry/Vulkan/Resource/BufferSlice.hpp"
 #include "Strawberry/Vulkan/Resource/Image.hpp"
 #include "Strawberry/Vulkan/Synchronisation/Fence.hpp"
 // Vulkan
@@ -13,6 +14,7 @@
 // Strawberry Core
 #include "Strawberry/Core/IO/DynamicByteBuffer.hpp"
 #include "Strawberry/Core/Math/Vector.hpp"
+#include "Strawberry/Core/Types/Optional.hpp"
 #include "Strawberry/Core/Types/ReflexivePointer.hpp"
 #include "Strawberry/Core/Types/Variant.hpp"
 // Standard Library
@@ -35,7 +37,7 @@ namespace Strawberry::Vulkan
 	class Swapchain;
 
 
-	using Barrier = Core::Variant<ImageMemoryBarrier>;
+	using Barrier = Core::Variant<ImageMemoryBarrier, VkMemoryBarrier>;
 
 
 	enum class CommandBufferState
@@ -112,7 +114,9 @@ namespace Strawberry::Vulkan
 
 
 		void BindVertexBuffer(uint32_t binding, const Buffer& buffer, VkDeviceSize offset = 0);
+		void BindVertexBuffer(uint32_t binding, const BufferSlice& slice);
 		void BindIndexBuffer(const Buffer& buffer, VkIndexType indexType, uint32_t offset = 0);
+		void BindIndexBuffer(const BufferSlice& slice, VkIndexType indexType);
 		void Draw(uint32_t vertexCount, uint32_t instanceCount = 1, uint32_t vertexOffset = 0, uint32_t instanceOffset = 0);
 		void DrawIndexed(uint32_t indexCount, uint32_t instanceCount = 1, uint32_t firstIndex = 0, uint32_t firstInstance = 0, int32_t vertexOffset = 0);
 
@@ -125,6 +129,8 @@ namespace Strawberry::Vulkan
 
 		void CopyBufferToImage(const Buffer& buffer, Image& image, uint32_t arrayLayer = 0);
 		void CopyBufferToImage(const CommandCopyBufferToImage& command);
+		// Copies the whole of the source slice to the start of the destination slice.
+		void CopyBufferToBuffer(const BufferSlice& source, const BufferSlice& destination);
 		void CopyImageToImage(const Image& source, VkImageLayout srcLayout, const Image& dest, VkImageLayout destLayout, VkImageAspectFlags aspect);
 		void BlitImage(const Image&       source,
 		               VkImageLayout      srcLayout,
@@ -149,6 +155,20 @@ namespace Strawberry::Vulkan
 		void BindDescriptorSets(const ComputePipeline& pipeline, uint32_t firstSet, std::vector<DescriptorSet*> sets);
 
 
+	private:
+		// The fence signalled by the batch a command buffer was submitted in, if it was not the command buffer's own.
+		struct BatchFence
+		{
+			Core::ReflexivePointer<Fence> fence;
+			// The number of times the fence had been reset when the batch was submitted. It cannot be reset again while
+			// the batch is pending, so once it has been, the batch has completed.
+			uint64_t                      resetCount;
+
+
+			[[nodiscard]] bool Signaled() const noexcept;
+		};
+
+
 	private:
 		static Core::Variant<Fence, Core::ReflexivePointer<CommandBuffer>> ConstructExecutionFence(const Device& device, VkCommandBufferLevel level);
 		void                                                               MoveIntoPendingState() const noexcept;
@@ -161,6 +181,8 @@ namespace Strawberry::Vulkan
 		mutable CommandBufferState                                          mState = CommandBufferState::Initial;
 		bool                                                                mOneTimeSubmission;
 		mutable Core::Variant<Fence, Core::ReflexivePointer<CommandBuffer>> mExecutionFenceOrParentBuffer;
+		// Set while the command buffer's completion is tracked through another fence, see Queue::SubmitBatch().
+		mutable Core::Optional<BatchFence>                                  mBatchFence;
 
 		mutable std::vector<Core::ReflexivePointer<CommandBuffer>> mRecordedSecondaryBuffers;
 	};
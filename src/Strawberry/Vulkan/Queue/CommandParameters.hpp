@@ -1,6 +1,7 @@
 #pragma once
 
 
+#include "Strawberry/Vulkan/Resource/BufferSlice.hpp"
 #include "Strawberry/Vulkan/Resource/Image.hpp"
 
 
@@ -76,7 +77,14 @@ namespace Strawberry::Vulkan
 
 		CommandCopyBufferToImage& WithSrcBuffer(const Buffer& buffer)
 		{
-			mSrcBuffer = &buffer;
+			mSrcBuffer = BufferSlice(buffer);
+			return *this;
+		}
+
+		// Copies from the start of the given slice, which must hold the whole of the destination region.
+		CommandCopyBufferToImage& WithSrcBuffer(const BufferSlice& slice)
+		{
+			mSrcBuffer = slice;
 			return *this;
 		}
 
@@ -107,7 +115,7 @@ namespace Strawberry::Vulkan
 
 	private:
 		VkImageAspectFlags                mAspect = VK_IMAGE_ASPECT_COLOR_BIT;
-		const Buffer*                     mSrcBuffer;
+		Core::Optional<BufferSlice>       mSrcBuffer;
 		Image*                            mDstImage;
 		uint32_t                          mDstArrayLayer = 0;
 		Core::Math::Vec3u                 mDstOffset;
@@ -0,0 +1,105 @@
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+#include "Strawberry/Vulkan/Queue/FileStreamer.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+// Standard Library
+#include <algorithm>
+#include <fstream>
+
+
+//======================================================================================================================
+//  Class Definitions
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	double FileStreamer::Statistics::ReadBytesPerSecond() const noexcept
+	{
+		const double seconds = std::chrono::duration<double>(readTime).count();
+		return seconds > 0.0 ? static_cast<double>(bytesRead) / seconds : 0.0;
+	}
+
+
+	double FileStreamer::Statistics::BytesPerSecond() const noexcept
+	{
+		const double seconds = std::chrono::duration<double>(totalTime).count();
+		return seconds > 0.0 ? static_cast<double>(bytesRead) / seconds : 0.0;
+	}
+
+
+	FileStreamer::FileStreamer(Queue& queue, VkDeviceSize stagingSize, size_t chunkSize, size_t flushInterval)
+		: mUploads(queue, stagingSize)
+		, mChunkSize(chunkSize)
+		, mFlushInterval(flushInterval)
+	{
+		Core::Assert(chunkSize > 0);
+	}
+
+
+	Core::Optional<UploadManager::Token> FileStreamer::Stream(const std::filesystem::path& file, const BufferSlice& destination)
+	{
+		std::error_code error;
+		const uint64_t size = std::filesystem::file_size(file, error);
+		if (error)
+		{
+			return Core::NullOpt;
+		}
+
+		return Stream(file, destination, 0, size);
+	}
+
+
+	Core::Optional<UploadManager::Token> FileStreamer::Stream(const std::filesystem::path& file, const BufferSlice& destination, uint64_t fileOffset, uint64_t size)
+	{
+		ZoneScoped;
+
+		Core::Assert(size <= destination.size);
+		const auto startTime = std::chrono::steady_clock::now();
+
+		// Without a buffer of its own, the stream reads straight into the staging memory it is given.
+		std::ifstream stream;
+		stream.rdbuf()->pubsetbuf(nullptr, 0);
+		stream.open(file, std::ios::binary);
+		if (!stream || !stream.seekg(static_cast<std::streamoff>(fileOffset)))
+		{
+			return Core::NullOpt;
+		}
+
+		const auto readChunk = [&](uint8_t* staging, size_t chunkSize)
+		{
+			const auto readStart = std::chrono::steady_clock::now();
+			stream.read(reinterpret_cast<char*>(staging), static_cast<std::streamsize>(chunkSize));
+			mStatistics.readTime += std::chrono::steady_clock::now() - readStart;
+
+			const size_t read = static_cast<size_t>(stream.gcount());
+			mStatistics.bytesRead += read;
+			return read == chunkSize;
+		};
+
+		bool succeeded = true;
+		size_t unflushed = 0;
+		for (uint64_t offset = 0; offset < size && succeeded; offset += mChunkSize)
+		{
+			const size_t chunkSize = static_cast<size_t>(std::min<uint64_t>(mChunkSize, size - offset));
+			succeeded = mUploads.Upload(destination.Subslice(offset, chunkSize), chunkSize, readChunk);
+
+			// Submit what has been read so far, so the device copies it while the next chunks are read.
+			unflushed += chunkSize;
+			if (unflushed >= mFlushInterval)
+			{
+				mUploads.Flush();
+				unflushed = 0;
+			}
+		}
+
+		const UploadManager::Token token = mUploads.Flush();
+		mStatistics.totalTime += std::chrono::steady_clock::now() - startTime;
+
+		if (!succeeded)
+		{
+			return Core::NullOpt;
+		}
+		return token;
+	}
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+// Strawberry Vulkan
+#include "Strawberry/Vulkan/Queue/UploadManager.hpp"
+#include "Strawberry/Vulkan/Resource/BufferSlice.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Types/Optional.hpp"
+// Standard Library
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+
+
+//======================================================================================================================
+//  Class Declaration
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	// Loads files into buffers by reading them straight into an UploadManager's staging memory, rather than reading
+	// them into host memory of their own first.
+	//
+	// Files are read in large chunks, and the uploads are flushed every few chunks, so that the device copies one part
+	// of a file while the next is being read. Peak host memory use is bounded by the size of the staging ring.
+	//
+	// Each streamer has an UploadManager of its own, as the manager is locked while files are read into its staging
+	// memory. Streaming through the device's would hold up every other upload on disk reads. Uploads are made visible
+	// to later commands on the given queue, and other queues must wait for the token of the stream, see Wait().
+	//
+	// The bytes read and time taken are recorded, see GetStatistics(). Streamers are not thread safe.
+	class FileStreamer
+	{
+	public:
+		struct Statistics
+		{
+			// The number of bytes read into staging memory.
+			uint64_t                 bytesRead = 0;
+			// The time spent reading files.
+			std::chrono::nanoseconds readTime  = std::chrono::nanoseconds::zero();
+			// The time spent in Stream(), which includes waiting for staging memory to be free.
+			std::chrono::nanoseconds totalTime = std::chrono::nanoseconds::zero();
+
+
+			// Returns the rate at which files were read from disk.
+			[[nodiscard]] double ReadBytesPerSecond() const noexcept;
+			// Returns the rate at which files were streamed overall.
+			[[nodiscard]] double BytesPerSecond() const noexcept;
+		};
+
+
+		// Reads files in chunks of the given size into a staging ring of the given size, flushing uploads each time the
+		// given number of bytes has been read.
+		explicit FileStreamer(Queue&       queue,
+		                      VkDeviceSize stagingSize   = 64 * 1024 * 1024,
+		                      size_t       chunkSize     = 4 * 1024 * 1024,
+		                      size_t       flushInterval = 16 * 1024 * 1024);
+
+
+		// Streams the whole of the given file to the start of the given slice, returning the token of the flush which
+		// completes the upload. Returns nothing if the file could not be read, in which case the slice's contents are
+		// undefined.
+		Core::Optional<UploadManager::Token> Stream(const std::filesystem::path& file, const BufferSlice& destination);
+		// Streams the given range of the given file to the start of the given slice.
+		Core::Optional<UploadManager::Token> Stream(const std::filesystem::path& file, const BufferSlice& destination, uint64_t fileOffset, uint64_t size);
+
+
+		// Returns whether the stream which returned the given token has completed.
+		[[nodiscard]] bool IsComplete(UploadManager::Token token) const { return mUploads.IsComplete(token); }
+		// Blocks until the stream which returned the given token has completed.
+		void Wait(UploadManager::Token token) { mUploads.Wait(token); }
+
+
+		[[nodiscard]] const Statistics& GetStatistics() const noexcept { return mStatistics; }
+		void ResetStatistics() noexcept { mStatistics = {}; }
+
+
+	private:
+		UploadManager mUploads;
+		size_t        mChunkSize;
+		size_t        mFlushInterval;
+		Statistics    mStatistics;
+	};
+}
@@ -3,11 +3,13 @@
 //----------------------------------------------------------------------------------------------------------------------
 #include "Strawberry/Vulkan/Queue/Queue.hpp"
 #include "Strawberry/Vulkan/Device/Device.hpp"
+#include "Strawberry/Vulkan/Memory/DeferredReleaseQueue.hpp"
 #include "Strawberry/Vulkan/Queue/CommandBuffer.hpp"
 // Strawberry Core
 #include "Strawberry/Core/Assert.hpp"
 // Standard Library
 #include <memory>
+#include <vector>
 
 
 //======================================================================================================================
@@ -15,6 +17,35 @@
 //----------------------------------------------------------------------------------------------------------------------
 namespace Strawberry::Vulkan
 {
+	SubmitBatchInfo& SubmitBatchInfo::WithCommandBuffer(const CommandBuffer& commandBuffer)
+	{
+		mCommandBuffers.emplace_back(&commandBuffer);
+		return *this;
+	}
+
+
+	SubmitBatchInfo& SubmitBatchInfo::WithWaitSemaphore(VkSemaphore semaphore, VkPipelineStageFlags stages)
+	{
+		mWaitSemaphores.emplace_back(semaphore);
+		mWaitStages.emplace_back(stages);
+		return *this;
+	}
+
+
+	SubmitBatchInfo& SubmitBatchInfo::WithSignalSemaphore(VkSemaphore semaphore)
+	{
+		mSignalSemaphores.emplace_back(semaphore);
+		return *this;
+	}
+
+
+	SubmitBatchInfo& SubmitBatchInfo::WithFence(Fence& fence)
+	{
+		mFence = &fence;
+		return *this;
+	}
+
+
 	Queue::Queue(Device& device, uint32_t family, uint32_t index, VkQueueFlags queueProperties)
 		: mFamilyIndex(family)
 		, mDevice(device)
@@ -29,6 +60,7 @@ namespace Strawberry::Vulkan
 		, mFamilyIndex(std::exchange(rhs.mFamilyIndex, 0))
 		, mDevice(std::move(rhs.mDevice))
 		, mQueueFlags(std::exchange(rhs.mQueueFlags, 0))
+		, mPendingSubmissions(std::move(rhs.mPendingSubmissions))
 	{}
 
 
@@ -55,28 +87,76 @@ namespace Strawberry::Vulkan
 	}
 
 
-	void Queue::Submit(const CommandBuffer& commandBuffer)
+	uint64_t Queue::Submit(const CommandBuffer& commandBuffer)
+	{
+		return SubmitBatch(SubmitBatchInfo().WithCommandBuffer(commandBuffer));
+	}
+
+
+	uint64_t Queue::SubmitBatch(const SubmitBatchInfo& batch)
 	{
 		ZoneScoped;
 
-		Core::AssertEQ(commandBuffer.Level(), VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+		Core::Assert(!batch.mCommandBuffers.empty(), "Batches must contain at least one command buffer!");
+
+		std::vector<VkCommandBuffer> handles;
+		handles.reserve(batch.mCommandBuffers.size());
+		for (const CommandBuffer* commandBuffer : batch.mCommandBuffers)
+		{
+			Core::AssertEQ(commandBuffer->Level(), VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+			handles.emplace_back(*commandBuffer);
+		}
 
-		VkCommandBuffer handle = commandBuffer;
-		VkSubmitInfo    submitInfo{
+		const VkSubmitInfo submitInfo{
 			.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO,
 			.pNext = nullptr,
-			.waitSemaphoreCount = 0,
-			.pWaitSemaphores = nullptr,
-			.pWaitDstStageMask = nullptr,
-			.commandBufferCount = 1,
-			.pCommandBuffers = &handle,
-			.signalSemaphoreCount = 0,
-			.pSignalSemaphores = nullptr,
+			.waitSemaphoreCount = static_cast<uint32_t>(batch.mWaitSemaphores.size()),
+			.pWaitSemaphores = batch.mWaitSemaphores.data(),
+			.pWaitDstStageMask = batch.mWaitStages.data(),
+			.commandBufferCount = static_cast<uint32_t>(handles.size()),
+			.pCommandBuffers = handles.data(),
+			.signalSemaphoreCount = static_cast<uint32_t>(batch.mSignalSemaphores.size()),
+			.pSignalSemaphores = batch.mSignalSemaphores.data(),
 		};
 
-		commandBuffer.mExecutionFenceOrParentBuffer.Ptr<Fence>()->Reset();
-		commandBuffer.MoveIntoPendingState();
-		Core::AssertEQ(vkQueueSubmit(mQueue, 1, &submitInfo, commandBuffer.mExecutionFenceOrParentBuffer.Ptr<Fence>()->mFence), VK_SUCCESS);
+		// Only one fence can be signalled per submission. Unless one is given, the last command buffer's own fence is
+		// used, and the rest of the batch tracks its completion through that.
+		const CommandBuffer& last  = *batch.mCommandBuffers.back();
+		Fence&               fence = batch.mFence ? *batch.mFence : *last.mExecutionFenceOrParentBuffer.Ptr<Fence>();
+
+		uint64_t submission;
+		{
+			// Number the submission under the lock, so that the device never sees a number before it is pending here.
+			std::scoped_lock lock(mSubmissionMutex);
+			fence.Reset();
+			for (const CommandBuffer* commandBuffer : batch.mCommandBuffers)
+			{
+				if (commandBuffer->mExecutionFenceOrParentBuffer.Ptr<Fence>() == &fence)
+				{
+					commandBuffer->mBatchFence = Core::NullOpt;
+				}
+				else
+				{
+					commandBuffer->mBatchFence = CommandBuffer::BatchFence{
+						.fence = Core::ReflexivePointer<Fence>(fence),
+						.resetCount = fence.ResetCount(),
+					};
+				}
+				commandBuffer->MoveIntoPendingState();
+			}
+			Core::AssertEQ(vkQueueSubmit(mQueue, 1, &submitInfo, fence.mFence), VK_SUCCESS);
+
+			submission = mDevice->NextSubmission();
+			mPendingSubmissions.emplace_back(PendingSubmission{
+				.submission = submission,
+				.fence = Core::ReflexivePointer<Fence>(fence),
+				.resetCount = fence.ResetCount(),
+			});
+		}
+
+		// Now is a good time to release resources whose last use has completed.
+		mDevice->GetDeferredReleases().Collect();
+		return submission;
 	}
 
 
@@ -90,6 +170,24 @@ namespace Strawberry::Vulkan
 	}
 
 
+	Core::Optional<uint64_t> Queue::OldestPendingSubmission() const
+	{
+		std::scoped_lock lock(mSubmissionMutex);
+		while (!mPendingSubmissions.empty())
+		{
+			// Newer submissions may have completed out of order, but are counted as pending until the oldest has.
+			const PendingSubmission& oldest = mPendingSubmissions.front();
+			if (!oldest.IsComplete())
+			{
+				return oldest.submission;
+			}
+			mPendingSubmissions.pop_front();
+		}
+
+		return Core::NullOpt;
+	}
+
+
 	Device& Queue::GetDevice()
 	{
 		return *mDevice;
@@ -106,4 +204,10 @@ namespace Strawberry::Vulkan
 	{
 		return mFamilyIndex;
 	}
+
+
+	bool Queue::PendingSubmission::IsComplete() const noexcept
+	{
+		return !fence || fence->ResetCount() != resetCount || fence->Signaled();
+	}
 }
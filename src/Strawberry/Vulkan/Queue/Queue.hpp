@@ -10,7 +10,12 @@
 #include <vulkan/vulkan.h>
 // Strawberry Core
 #include <future>
+#include <Strawberry/Core/Types/Optional.hpp>
 #include <Strawberry/Core/Types/ReflexivePointer.hpp>
+// Standard Library
+#include <deque>
+#include <mutex>
+#include <vector>
 
 
 //======================================================================================================================
@@ -22,6 +27,31 @@ namespace Strawberry::Vulkan
 	class CommandBuffer;
 
 
+	// Command buffers and semaphores to be submitted together, see Queue::SubmitBatch(). Command buffers execute in the
+	// order they were added, after every wait semaphore has been signalled, and the signal semaphores and fence are
+	// signalled once all of them have completed.
+	class SubmitBatchInfo
+	{
+		friend class Queue;
+
+	public:
+		SubmitBatchInfo& WithCommandBuffer(const CommandBuffer& commandBuffer);
+		// Commands in the given stages wait for the semaphore to be signalled.
+		SubmitBatchInfo& WithWaitSemaphore(VkSemaphore semaphore, VkPipelineStageFlags stages);
+		SubmitBatchInfo& WithSignalSemaphore(VkSemaphore semaphore);
+		// Signals the given fence when the batch completes. It is reset before the batch is submitted.
+		SubmitBatchInfo& WithFence(Fence& fence);
+
+
+	private:
+		std::vector<const CommandBuffer*>  mCommandBuffers;
+		std::vector<VkSemaphore>           mWaitSemaphores;
+		std::vector<VkPipelineStageFlags>  mWaitStages;
+		std::vector<VkSemaphore>           mSignalSemaphores;
+		Fence*                             mFence = nullptr;
+	};
+
+
 	class Queue
 			: public Core::EnableReflexivePointer
 	{
@@ -37,10 +67,18 @@ namespace Strawberry::Vulkan
 		~Queue();
 
 
-		void Submit(const CommandBuffer& commandBuffer);
+		// Submits the command buffer, returning the number it was given on the device's submission timeline.
+		uint64_t Submit(const CommandBuffer& commandBuffer);
+		// Submits every command buffer in the batch at once, returning the one number they share on the device's
+		// submission timeline. The batch must contain at least one command buffer.
+		uint64_t SubmitBatch(const SubmitBatchInfo& batch);
 		void WaitUntilIdle() const;
 
 
+		// Returns the number of the oldest submission to this queue which may not have completed yet, if there is one.
+		Core::Optional<uint64_t> OldestPendingSubmission() const;
+
+
 		Device& GetDevice();
 		const Device& GetDevice() const;
 
@@ -55,9 +93,27 @@ namespace Strawberry::Vulkan
 
 
 	private:
+		struct PendingSubmission
+		{
+			uint64_t                      submission;
+			// Completion is read straight from the fence the submission signals, rather than through its command
+			// buffers, which belong to whichever thread recorded them. The fence cannot be reset or destroyed while
+			// the submission is pending, so once it has been, the submission has completed.
+			Core::ReflexivePointer<Fence> fence;
+			uint64_t                      resetCount;
+
+
+			[[nodiscard]] bool IsComplete() const noexcept;
+		};
+
+
 		VkQueue                        mQueue;
 		uint32_t                       mFamilyIndex;
 		Core::ReflexivePointer<Device> mDevice;
 		VkQueueFlags                   mQueueFlags;
+
+		mutable std::mutex                    mSubmissionMutex;
+		// Submissions to this queue which may not have completed, oldest first.
+		mutable std::deque<PendingSubmission> mPendingSubmissions;
 	};
 }
@@ -0,0 +1,341 @@
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+#include "Strawberry/Vulkan/Queue/UploadManager.hpp"
+#include "Strawberry/Vulkan/Device/Device.hpp"
+#include "Strawberry/Vulkan/Queue/ImageMemoryBarrier.hpp"
+#include "Strawberry/Vulkan/Queue/Queue.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+// Standard Library
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+
+//======================================================================================================================
+//  Class Definitions
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	UploadManager::UploadManager(Queue& queue, VkDeviceSize stagingSize)
+		: mQueue(queue)
+		, mCommandPool(queue, true)
+		, mStagingBuffer(VK_NULL_HANDLE)
+		, mStagingWrites(queue.GetDevice())
+	{
+		Device& device = queue.GetDevice();
+
+		const VkBufferCreateInfo createInfo{
+			.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.size = stagingSize,
+			.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+			.queueFamilyIndexCount = 0,
+			.pQueueFamilyIndices = nullptr,
+		};
+		Core::AssertEQ(vkCreateBuffer(device.Handle(), &createInfo, nullptr, &mStagingBuffer), VK_SUCCESS);
+
+		VkMemoryRequirements requirements;
+		vkGetBufferMemoryRequirements(device.Handle(), mStagingBuffer, &requirements);
+
+		// Take the most preferred host visible memory type that the staging buffer can live in.
+		const auto memoryTypes = device.GetPhysicalDevice().SearchMemoryTypes(MemoryTypeCriteria::HostVisible());
+		auto memoryType = std::ranges::find_if(memoryTypes, [&](const MemoryType& type)
+		{
+			return requirements.memoryTypeBits & (1 << type.index.memoryTypeIndex);
+		});
+		Core::Assert(memoryType != memoryTypes.end());
+
+		// The ring hands out offsets into the whole pool, so the buffer is bound to the whole of it.
+		MemoryPool pool = MemoryPool::Allocate(device, memoryType->index, std::max(stagingSize, requirements.size)).Unwrap();
+		Core::AssertEQ(vkBindBufferMemory(device.Handle(), mStagingBuffer, pool.Memory(), 0), VK_SUCCESS);
+		mStagingRing = std::make_unique<RingAllocator>(std::move(pool));
+	}
+
+
+	UploadManager::~UploadManager()
+	{
+		ZoneScoped;
+
+		// Uploads which were never flushed are still submitted, so that their resources hold what was asked of them.
+		Wait(Flush());
+		mSubmissions.clear();
+		mSpareCommandBuffers.clear();
+		mSpareFences.clear();
+		vkDestroyBuffer(mQueue->GetDevice().Handle(), mStagingBuffer, nullptr);
+	}
+
+
+	void UploadManager::Upload(const BufferSlice& destination, const Core::IO::DynamicByteBuffer& bytes)
+	{
+		Upload(destination, bytes.Data(), bytes.Size());
+	}
+
+
+	void UploadManager::Upload(const BufferSlice& destination, const void* data, size_t size)
+	{
+		ZoneScoped;
+
+		std::lock_guard lock(mMutex);
+		Core::Assert(size <= destination.size);
+		if (size == 0) return;
+
+		RecordCopy(Stage(data, size, 4), destination.Subslice(0, size));
+	}
+
+
+	bool UploadManager::Upload(const BufferSlice& destination, size_t size, const StagingWriter& writer)
+	{
+		ZoneScoped;
+
+		std::lock_guard lock(mMutex);
+		Core::Assert(size <= destination.size);
+		if (size == 0) return true;
+
+		Core::Optional<BufferSlice> staging = Stage(size, 4, writer);
+		if (!staging)
+		{
+			return false;
+		}
+
+		RecordCopy(*staging, destination.Subslice(0, size));
+		return true;
+	}
+
+
+	void UploadManager::Upload(Image& image, const Core::IO::DynamicByteBuffer& bytes, VkImageLayout finalLayout, VkImageAspectFlags aspect, uint32_t arrayLayer)
+	{
+		ZoneScoped;
+
+		std::lock_guard lock(mMutex);
+
+		// Buffer offsets of image copies must be a multiple of the texel size, which is at most 16 bytes.
+		const BufferSlice staging = Stage(bytes.Data(), bytes.Size(), 16);
+
+		const VkImageSubresourceRange layer{
+			.aspectMask = aspect,
+			.baseMipLevel = 0,
+			.levelCount = VK_REMAINING_MIP_LEVELS,
+			.baseArrayLayer = arrayLayer,
+			.layerCount = 1,
+		};
+
+		CommandBuffer& commandBuffer = Recording();
+		commandBuffer.PipelineBarrier(
+			VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+			VK_PIPELINE_STAGE_TRANSFER_BIT,
+			0,
+			{
+				ImageMemoryBarrier(image, aspect)
+					.WithSubresourceRange(layer)
+					.WithDstAccessMask(VK_ACCESS_TRANSFER_WRITE_BIT)
+					.ToLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
+			});
+		commandBuffer.CopyBufferToImage(CommandCopyBufferToImage()
+			.WithSrcBuffer(staging)
+			.WithDstImage(image)
+			.WithAspect(aspect)
+			.WithDstArrayLayer(arrayLayer));
+
+		mVisibilityBarriers.emplace_back(
+			ImageMemoryBarrier(image, aspect)
+				.WithSubresourceRange(layer)
+				.WithSrcAccessMask(VK_ACCESS_TRANSFER_WRITE_BIT)
+				.WithDstAccessMask(VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT)
+				.FromLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
+				.ToLayout(finalLayout));
+	}
+
+
+	UploadManager::Token UploadManager::Flush()
+	{
+		std::lock_guard lock(mMutex);
+		return Submit();
+	}
+
+
+	bool UploadManager::IsComplete(Token token) const
+	{
+		return token.submission <= mQueue->GetDevice().CompletedSubmission();
+	}
+
+
+	void UploadManager::Wait(Token token)
+	{
+		ZoneScoped;
+
+		// Only the fences are taken under the lock, so that uploads from other threads are not held up by the GPU.
+		std::vector<std::shared_ptr<Fence>> fences;
+		{
+			std::lock_guard lock(mMutex);
+			for (const Submission& submission : mSubmissions)
+			{
+				if (submission.submission > token.submission) break;
+				if (!submission.fence->Signaled())
+				{
+					fences.emplace_back(submission.fence);
+				}
+			}
+		}
+
+		for (const std::shared_ptr<Fence>& fence : fences)
+		{
+			fence->Wait();
+		}
+	}
+
+
+	BufferSlice UploadManager::Stage(const void* data, size_t size, VkDeviceSize alignment)
+	{
+		return Stage(size, alignment, [data](uint8_t* staging, size_t size)
+		{
+			std::memcpy(staging, data, size);
+			return true;
+		}).Unwrap();
+	}
+
+
+	Core::Optional<BufferSlice> UploadManager::Stage(size_t size, VkDeviceSize alignment, const StagingWriter& writer)
+	{
+		const AllocationRequest request = AllocationRequest(size, alignment)
+			.WithResourceKind(ResourceKind::Linear);
+
+		// Too large for the ring at all, so give the upload a staging buffer of its own.
+		if (size > mStagingRing->Memory().Size())
+		{
+			Buffer& buffer = mOversizedStaging.emplace_back(
+				Buffer::Builder(mQueue->GetDevice(), MemoryTypeCriteria::HostVisible())
+					.WithSize(size)
+					.WithUsage(VK_BUFFER_USAGE_TRANSFER_SRC_BIT)
+					.Build());
+			if (!writer(buffer.GetData(), size))
+			{
+				mOversizedStaging.pop_back();
+				return Core::NullOpt;
+			}
+			mStagingWrites.Add(buffer.GetMemory(), 0, size);
+			return BufferSlice(buffer);
+		}
+
+		AllocationResult allocation = mStagingRing->Allocate(request);
+		if (!allocation)
+		{
+			// The rest of the ring is taken by uploads which have not been submitted, so submit them to make room.
+			Submit();
+			allocation = mStagingRing->Allocate(request);
+		}
+		const MemoryBlock block = allocation.Unwrap();
+
+		// Space the writer failed to fill is left unused until the ring is next retired.
+		if (!writer(block.GetMappedAddress(), size))
+		{
+			return Core::NullOpt;
+		}
+		mStagingWrites.Add(block, 0, size);
+
+		// The staging buffer is bound to the start of the ring's pool, so pool offsets are buffer offsets.
+		return BufferSlice(mStagingBuffer, block.Offset(), size);
+	}
+
+
+	void UploadManager::RecordCopy(const BufferSlice& staging, const BufferSlice& destination)
+	{
+		Recording().CopyBufferToBuffer(staging, destination);
+
+		// One memory barrier covers every buffer upload in the batch.
+		const bool hasMemoryBarrier = std::ranges::any_of(mVisibilityBarriers, [](const Barrier& barrier)
+		{
+			return barrier.IsType<VkMemoryBarrier>();
+		});
+		if (!hasMemoryBarrier)
+		{
+			mVisibilityBarriers.emplace_back(VkMemoryBarrier{
+				.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+				.pNext = nullptr,
+				.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+				.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT,
+			});
+		}
+	}
+
+
+	CommandBuffer& UploadManager::Recording()
+	{
+		if (mRecording)
+		{
+			return *mRecording;
+		}
+
+		// Reuse the command buffers of completed uploads.
+		while (!mSubmissions.empty() && mSubmissions.front().commandBuffer.State() != CommandBufferState::Pending)
+		{
+			Submission& oldest = mSubmissions.front();
+			mSpareCommandBuffers.emplace_back(std::move(oldest.commandBuffer));
+			// Fences still held by a Wait() are left to it.
+			if (oldest.fence.use_count() == 1)
+			{
+				mSpareFences.emplace_back(std::move(oldest.fence));
+			}
+			mSubmissions.pop_front();
+		}
+
+		if (mSpareCommandBuffers.empty())
+		{
+			mRecording.Emplace(mCommandPool);
+		}
+		else
+		{
+			mRecording.Emplace(std::move(mSpareCommandBuffers.back()));
+			mSpareCommandBuffers.pop_back();
+			mRecording->Reset();
+		}
+
+		mRecording->Begin(true);
+		return *mRecording;
+	}
+
+
+	UploadManager::Token UploadManager::Submit()
+	{
+		ZoneScoped;
+
+		if (!mRecording)
+		{
+			return mLastFlush;
+		}
+
+		// The queue and staging ring keep pointers to the command buffer, so it is put where it will stay before either
+		// is given it.
+		std::shared_ptr<Fence> fence;
+		if (mSpareFences.empty())
+		{
+			fence = std::make_shared<Fence>(mQueue->GetDevice());
+		}
+		else
+		{
+			fence = std::move(mSpareFences.back());
+			mSpareFences.pop_back();
+		}
+
+		Submission&    submission    = mSubmissions.emplace_back(Submission{
+			.submission = 0, .commandBuffer = mRecording.Unwrap(), .fence = std::move(fence)});
+		CommandBuffer& commandBuffer = submission.commandBuffer;
+		commandBuffer.PipelineBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, mVisibilityBarriers);
+		commandBuffer.End();
+		mVisibilityBarriers.clear();
+
+		mStagingWrites.Flush();
+		submission.submission = mLastFlush.submission = mQueue->SubmitBatch(SubmitBatchInfo()
+			.WithCommandBuffer(commandBuffer)
+			.WithFence(*submission.fence));
+
+		// The staging space is reused once the command buffer has completed, and oversized staging buffers are
+		// destroyed once it has, as they are released after it is submitted.
+		mStagingRing->Retire(commandBuffer);
+		mOversizedStaging.clear();
+		return mLastFlush;
+	}
+}
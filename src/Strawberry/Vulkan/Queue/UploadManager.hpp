@@ -0,0 +1,147 @@
+#pragma once
+
+
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+// Strawberry Vulkan
+#include "Strawberry/Vulkan/Memory/MappedRangeBatch.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/RingAllocator.hpp"
+#include "Strawberry/Vulkan/Queue/CommandBuffer.hpp"
+#include "Strawberry/Vulkan/Queue/CommandPool.hpp"
+#include "Strawberry/Vulkan/Resource/Buffer.hpp"
+#include "Strawberry/Vulkan/Resource/BufferSlice.hpp"
+#include "Strawberry/Vulkan/Resource/Image.hpp"
+#include "Strawberry/Vulkan/Synchronisation/Fence.hpp"
+// Strawberry Core
+#include "Strawberry/Core/IO/DynamicByteBuffer.hpp"
+#include "Strawberry/Core/Types/Optional.hpp"
+#include "Strawberry/Core/Types/ReflexivePointer.hpp"
+// Vulkan
+#include <vulkan/vulkan.h>
+// Standard Library
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+//======================================================================================================================
+//  Class Declaration
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	class Queue;
+
+
+	// Copies data from the host into buffers and images which the host cannot write to, such as those in device local
+	// memory.
+	//
+	// Data is copied into a ring of persistently mapped staging memory as it is queued, and the copies out of it are
+	// recorded into a single command buffer, which is only submitted on Flush(), or when the ring is full. Uploads
+	// larger than the whole ring are staged in buffers of their own.
+	//
+	// The queue must be able to transfer, and should belong to the family which uses the uploaded resources, as no
+	// ownership transfers are made. Uploads are made visible to all later commands on the same queue. Other queues
+	// must wait for the upload's token, see Wait(). Resources must not be destroyed before uploads to them are flushed.
+	//
+	// Every device has one of these, see Device::GetUploadManager(), which Buffer::Builder::WithData() uploads through,
+	// and waits on, for memory which is not host visible. Uploads are thread safe.
+	class UploadManager
+	{
+	public:
+		// Writes the given number of bytes of an upload into mapped staging memory, returning whether it succeeded.
+		using StagingWriter = std::function<bool(uint8_t* staging, size_t size)>;
+
+
+		// Identifies a flush, which can be waited on. Tokens of later flushes complete after those of earlier ones.
+		struct Token
+		{
+			// The number of the flush's submission on the device's timeline, or 0 if nothing was submitted.
+			uint64_t submission = 0;
+		};
+
+
+		explicit UploadManager(Queue& queue, VkDeviceSize stagingSize = 64 * 1024 * 1024);
+		UploadManager(const UploadManager&)            = delete;
+		UploadManager& operator=(const UploadManager&) = delete;
+		~UploadManager();
+
+
+		// Queues a copy of the given bytes to the start of the given slice.
+		void Upload(const BufferSlice& destination, const Core::IO::DynamicByteBuffer& bytes);
+		// Queues a copy of the given range of host memory to the start of the given slice. The memory is copied before
+		// this returns.
+		void Upload(const BufferSlice& destination, const void* data, size_t size);
+		// Queues a copy of the given number of bytes to the start of the given slice, which the writer fills staging
+		// memory with directly, e.g. from a file. Nothing is uploaded if the writer fails, which is returned. The
+		// manager stays locked while the writer runs, so slow writers should have a manager of their own.
+		bool Upload(const BufferSlice& destination, size_t size, const StagingWriter& writer);
+		// Queues a copy of the given bytes to the whole of one array layer of an image, which is then moved into the
+		// given layout. The previous contents of the layer are discarded.
+		void Upload(Image&                             image,
+		            const Core::IO::DynamicByteBuffer& bytes,
+		            VkImageLayout                      finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+		            VkImageAspectFlags                 aspect      = VK_IMAGE_ASPECT_COLOR_BIT,
+		            uint32_t                           arrayLayer  = 0);
+
+
+		// Submits every upload queued since the last flush in one command buffer, and returns a token which completes
+		// along with them. Returns the token of the last flush if nothing has been queued since.
+		Token Flush();
+
+
+		// Returns whether every upload flushed with the given token has completed.
+		[[nodiscard]] bool IsComplete(Token token) const;
+		// Blocks until every upload flushed with the given token has completed. Other threads may keep uploading while
+		// this waits.
+		void Wait(Token token);
+
+
+	private:
+		struct Submission
+		{
+			uint64_t               submission;
+			CommandBuffer          commandBuffer;
+			// Signalled when the submission completes. Wait() holds a reference while waiting on it without the lock,
+			// and fences are only reused once nothing else refers to them, so that one is never reset while waited on.
+			std::shared_ptr<Fence> fence;
+		};
+
+
+		// Copies the given bytes into staging memory, submitting the uploads queued so far if the ring is full.
+		BufferSlice Stage(const void* data, size_t size, VkDeviceSize alignment);
+		// Has the writer fill staging memory of the given size, returning it if the writer succeeded.
+		Core::Optional<BufferSlice> Stage(size_t size, VkDeviceSize alignment, const StagingWriter& writer);
+		// Records a copy out of staging memory into the given slice.
+		void RecordCopy(const BufferSlice& staging, const BufferSlice& destination);
+		// Returns the command buffer which uploads are being recorded into, beginning one if need be.
+		CommandBuffer& Recording();
+		// Submits the command buffer being recorded. Must be called with the mutex locked.
+		Token Submit();
+
+
+		Core::ReflexivePointer<Queue>  mQueue;
+		CommandPool                    mCommandPool;
+
+		// A buffer over the whole of the ring's memory, which uploads are copied out of.
+		VkBuffer                       mStagingBuffer;
+		std::unique_ptr<RingAllocator> mStagingRing;
+		// Staging writes to flush before the uploads are submitted.
+		MappedRangeBatch               mStagingWrites;
+		// Staging buffers for uploads which did not fit in the ring, kept until their uploads are submitted.
+		std::vector<Buffer>            mOversizedStaging;
+
+		Core::Optional<CommandBuffer>  mRecording;
+		// Barriers making the uploads recorded so far visible, which are made all at once when they are submitted.
+		std::vector<Barrier>           mVisibilityBarriers;
+		Token                          mLastFlush;
+		// Submitted command buffers which may not have completed, oldest first, and those which can be reused.
+		std::deque<Submission>         mSubmissions;
+		std::vector<CommandBuffer>     mSpareCommandBuffers;
+		std::vector<std::shared_ptr<Fence>> mSpareFences;
+
+		mutable std::mutex             mMutex;
+	};
+}
@@ -3,9 +3,16 @@
 //----------------------------------------------------------------------------------------------------------------------
 #include "Strawberry/Vulkan/Resource/Buffer.hpp"
 #include "Strawberry/Vulkan/Device/Device.hpp"
+#include "Strawberry/Vulkan/Memory/DeferredReleaseQueue.hpp"
+#include "Strawberry/Vulkan/Memory/HostMemoryImporter.hpp"
+#include "Strawberry/Vulkan/Memory/ResidencyManager.hpp"
+#include "Strawberry/Vulkan/Queue/UploadManager.hpp"
+#include "Strawberry/Vulkan/Resource/BufferSlice.hpp"
 // Strawberry Core
 #include "Strawberry/Core/Assert.hpp"
+#include "Strawberry/Core/IO/Logging.hpp"
 // Standard Library
+#include <cstring>
 #include <memory>
 
 
@@ -53,28 +60,57 @@ namespace Strawberry::Vulkan
 			[](size_t size)
 			{
 				return size;
+			},
+			[](const HostRange& range)
+			{
+				return range.size;
 			});
 	}
 
-	MemoryBlock Buffer::Builder::AllocateMemory(const VkMemoryRequirements& requirements) const
+	AllocationResult Buffer::Builder::AllocateMemory(const AllocationRequest& request) const
 	{
 		return mAllocationSource.Visit(
-			[&](MemoryBlock& allocation)
+			[&](MemoryBlock& allocation) -> AllocationResult
 			{
 				return std::move(allocation);
 			},
 			[&](MonoAllocator* allocator)
 			{
-				return allocator->Allocate( AllocationRequest(requirements)).Unwrap();
+				return allocator->Allocate(request);
 			},
 			[&](PolyAllocator* allocator)
 			{
-				return allocator->Allocate(AllocationRequest(requirements), mMemoryTypeCriteria).Unwrap();
+				return allocator->Allocate(request, mMemoryTypeCriteria);
 			}
 		);
 	}
 
 
+	AllocationResult Buffer::Builder::AllocateUnderPressure(const AllocationRequest& request) const
+	{
+		ZoneScoped;
+
+		// Only device local memory can be made room in, or stood in for by host memory.
+		if (!mAllocationSource.IsType<PolyAllocator*>() || (mMemoryTypeCriteria.requiredProperties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT))
+		{
+			return AllocationError::OutOfMemory();
+		}
+
+		if (GetDevice().GetResidencyManager().MakeRoom(request.size))
+		{
+			if (AllocationResult result = AllocateMemory(request))
+			{
+				return result;
+			}
+		}
+
+		// The device can still read host memory, only more slowly. A ResidencyManager moves the buffer into device
+		// local memory once there is room, if it is registered with one.
+		Core::Logging::Warning("Out of device local memory in Buffer::Builder::Build(). Falling back to host memory.");
+		return mAllocationSource.Ref<PolyAllocator*>()->Allocate(request, MemoryTypeCriteria::HostVisible());
+	}
+
+
 	Buffer::Builder::Builder(PolyAllocator& allocator, MemoryTypeCriteria memoryTypeCriteria)
 		: mAllocationSource(&allocator)
 		, mMemoryTypeCriteria(memoryTypeCriteria)
@@ -83,12 +119,27 @@ namespace Strawberry::Vulkan
 
 	Buffer Buffer::Builder::Build() const
 	{
+		ZoneScoped;
+
+		// Host data is used in place where possible, and otherwise copied like any other data.
+		if (mData.IsType<HostRange>())
+		{
+			if (Core::Optional<Buffer> imported = BuildImported(mData.Ref<HostRange>()))
+			{
+				return imported.Unwrap();
+			}
+		}
+
 		// Create Buffer
 		Buffer buffer {GetDevice().Handle(), GetSize(), mUsage};
-		// Get memory requirements
-		VkMemoryRequirements memoryRequirements = buffer.GetMemoryRequirements(GetDevice().Handle());
-		// Allocate memory
-		buffer.mMemory = AllocateMemory(memoryRequirements);
+		// Allocate memory, degrading gracefully if there is no more of the kind that was asked for.
+		const AllocationRequest request = buffer.GetAllocationRequest(GetDevice().Handle()).WithPriority(mPriority);
+		AllocationResult memory = AllocateMemory(request);
+		if (!memory)
+		{
+			memory = AllocateUnderPressure(request);
+		}
+		buffer.mMemory = memory.Unwrap();
 		// Bind memory to buffer
 		Core::AssertEQ(
 			vkBindBufferMemory(
@@ -98,25 +149,82 @@ namespace Strawberry::Vulkan
 				buffer.mMemory.Offset()),
 			VK_SUCCESS);
 
-		// Copy data into the buffer if required.
-		if (mData.IsType<Core::IO::DynamicByteBuffer>())
+		// Copy data into the buffer if required, through staging memory if the host cannot write to it directly.
+		if (!mData.IsType<size_t>())
 		{
 			Core::Assert(mUsage & VK_BUFFER_USAGE_TRANSFER_DST_BIT,
 				"Attempt to set the data of a buffer without VK_BUFFER_USAGE_TRANSFER_DST_BIT set in the usage!");
-			buffer.SetData(mData.Ref<Core::IO::DynamicByteBuffer>());
+
+			const void* data = mData.IsType<HostRange>()
+				? mData.Ref<HostRange>().data
+				: mData.Ref<Core::IO::DynamicByteBuffer>().Data();
+			const size_t size = GetSize();
+
+			if (buffer.mMemory.Properties() & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+			{
+				std::memcpy(buffer.GetData(), data, size);
+				buffer.Flush(0, size);
+			}
+			else
+			{
+				// The copy is completed before the buffer is returned, so that it is ordered before any of the
+				// caller's own work, and the buffer can never be released while the copy is still pending.
+				UploadManager& uploads = GetDevice().GetUploadManager();
+				uploads.Upload(BufferSlice(buffer), data, size);
+				uploads.Wait(uploads.Flush());
+			}
 		}
 
 		return buffer;
 	}
 
 
+	Core::Optional<Buffer> Buffer::Builder::BuildImported(const HostRange& range) const
+	{
+		HostMemoryImporter& importer = GetDevice().GetHostMemoryImporter();
+		// Memory given to the builder up front is used as it was asked to be.
+		if (mAllocationSource.IsType<MemoryBlock>() || !importer.CanImport(range.data, range.size))
+		{
+			return Core::NullOpt;
+		}
+
+		// Buffers must be told up front that they may be bound to imported memory.
+		const VkExternalMemoryBufferCreateInfo externalInfo
+		{
+			.sType = VK_STRUCTURE_TYPE_EXTERNAL_MEMORY_BUFFER_CREATE_INFO,
+			.pNext = nullptr,
+			.handleTypes = VK_EXTERNAL_MEMORY_HANDLE_TYPE_HOST_ALLOCATION_BIT_EXT,
+		};
+		Buffer buffer {GetDevice().Handle(), range.size, mUsage, &externalInfo};
+
+		const VkMemoryRequirements requirements = buffer.GetMemoryRequirements(GetDevice().Handle());
+		AllocationResult memory = requirements.size <= range.size
+			? importer.Import(range.data, range.size, requirements.memoryTypeBits)
+			: AllocationResult(AllocationError::OutOfMemory());
+		if (!memory)
+		{
+			// The buffer was never used, so can be destroyed straight away.
+			vkDestroyBuffer(GetDevice().Handle(), std::exchange(buffer.mHandle, VK_NULL_HANDLE), nullptr);
+			return Core::NullOpt;
+		}
+
+		buffer.mMemory = memory.Unwrap();
+		Core::AssertEQ(
+			vkBindBufferMemory(
+				GetDevice().Handle(),
+				buffer.mHandle,
+				buffer.mMemory.Memory(),
+				buffer.mMemory.Offset()),
+			VK_SUCCESS);
+		return buffer;
+	}
+
+
 	Buffer::Buffer(Buffer&& rhs) noexcept
 		: mSize(std::exchange(rhs.mSize, 0))
 		, mHandle(std::exchange(rhs.mHandle, nullptr))
 		, mMemory(std::move(rhs.mMemory))
-#ifdef STRAWBERRY_DEBUG
-        , mUsage(std::exchange(rhs.mUsage, 0))
-#endif
+		, mUsage(std::exchange(rhs.mUsage, 0))
 	{}
 
 
@@ -136,7 +244,8 @@ namespace Strawberry::Vulkan
 	{
 		if (mHandle)
 		{
-			vkDestroyBuffer(GetDevice(), mHandle, nullptr);
+			// The GPU may still be reading this buffer, so leave it to be destroyed once it has finished.
+			mMemory.GetDevice().GetDeferredReleases().ReleaseBuffer(mHandle, std::move(mMemory));
 		}
 	}
 
@@ -159,6 +268,16 @@ namespace Strawberry::Vulkan
 		mMemory.Overwrite(bytes);
 	}
 
+	void Buffer::Flush(size_t offset, size_t size) const
+	{
+		mMemory.Flush(offset, size);
+	}
+
+	void Buffer::Invalidate(size_t offset, size_t size) const
+	{
+		mMemory.Invalidate(offset, size);
+	}
+
 	uint8_t* Buffer::GetData()
 	{
 		return mMemory.GetMappedAddress();
@@ -174,16 +293,19 @@ namespace Strawberry::Vulkan
 		return mSize;
 	}
 
-	Buffer::Buffer(VkDevice device, size_t size, VkBufferUsageFlags usage)
+	const MemoryBlock& Buffer::GetMemory() const
+	{
+		return mMemory;
+	}
+
+	Buffer::Buffer(VkDevice device, size_t size, VkBufferUsageFlags usage, const void* next)
 		: mHandle(VK_NULL_HANDLE)
 		, mSize(size)
-#ifdef STRAWBERRY_DEBUG
 		, mUsage(usage)
-#endif
-{
+	{
 		VkBufferCreateInfo createInfo{
 			.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
-			.pNext = nullptr,
+			.pNext = next,
 			.flags = 0,
 			.size = size,
 			.usage = usage,
@@ -201,4 +323,33 @@ namespace Strawberry::Vulkan
 		vkGetBufferMemoryRequirements(device, mHandle, &memoryRequirements);
 		return memoryRequirements;
 	}
+
+	AllocationRequest Buffer::GetAllocationRequest(VkDevice device) const
+	{
+		const VkBufferMemoryRequirementsInfo2 requirementsInfo
+		{
+			.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_REQUIREMENTS_INFO_2,
+			.pNext = nullptr,
+			.buffer = mHandle,
+		};
+		VkMemoryDedicatedRequirements dedicatedRequirements
+		{
+			.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS,
+			.pNext = nullptr,
+		};
+		VkMemoryRequirements2 memoryRequirements
+		{
+			.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2,
+			.pNext = &dedicatedRequirements,
+		};
+		vkGetBufferMemoryRequirements2(device, &requirementsInfo, &memoryRequirements);
+
+		AllocationRequest request(memoryRequirements.memoryRequirements);
+		request.WithResourceKind(ResourceKind::Linear);
+		if (dedicatedRequirements.prefersDedicatedAllocation || dedicatedRequirements.requiresDedicatedAllocation)
+		{
+			request.WithDedicatedBuffer(mHandle, dedicatedRequirements.requiresDedicatedAllocation);
+		}
+		return request;
+	}
 }
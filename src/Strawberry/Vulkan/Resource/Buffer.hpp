@@ -9,6 +9,7 @@
 #include "Strawberry/Vulkan/Memory/Allocator/PolyAllocator.hpp"
 // Strawberry Core
 #include "Strawberry/Core/IO/DynamicByteBuffer.hpp"
+#include "Strawberry/Core/Types/Optional.hpp"
 // Vulkan
 #include <vulkan/vulkan.h>
 
@@ -23,38 +24,65 @@ namespace Strawberry::Vulkan
 
 	class Buffer
 	{
+		friend class Defragmenter;
+		friend class ResidencyManager;
+
 	public:
 		class Builder {
 		public:
 			Builder(Device& device, MemoryTypeCriteria memoryTypeCriteria);
 			Builder(MemoryBlock allocation);
+			// Unless the allocator is thread safe, the memory of buffers built this way is only freed once the thread
+			// using the allocator calls DeferredReleaseQueue::Reclaim() with it, see Device::GetDeferredReleases().
 			Builder(MonoAllocator& allocator);
 			Builder(PolyAllocator& allocator, MemoryTypeCriteria memoryTypeCriteria);
 
 
 			Builder& WithSize(size_t size) { mData = size; return *this; }
+			// Fills the buffer with the given bytes. Buffers which the host cannot write to are filled by the device's
+			// UploadManager, and Build() waits for the copy to complete. Use UploadManager::Upload() directly to batch
+			// uploads without waiting.
 			Builder& WithData(const Core::IO::DynamicByteBuffer& bytes) { mData = bytes; return *this; }
+			// Fills the buffer with the given range of host memory without copying it, by importing it as the buffer's
+			// memory, see HostMemoryImporter. The host memory must then outlive the buffer, and any GPU work using it.
+			// Where the memory cannot be imported, it is copied as with WithData(), and the memory criteria are used.
+			Builder& WithHostData(const void* data, size_t size) { mData = HostRange{data, size}; return *this; }
 			Builder& WithAlignment(size_t alignment) { mAlignment = alignment; return *this; }
 			Builder& WithUsage(VkBufferUsageFlags usage) { mUsage = usage; return *this; }
 			Builder& WithMemoryTypeCriteria(MemoryTypeCriteria criteria) { mMemoryTypeCriteria = criteria; return *this; }
+			// Sets how important it is that the buffer stays in device local memory, see AllocationRequest::WithPriority().
+			Builder& WithPriority(float priority) { mPriority = priority; return *this; }
 
 
 			Buffer Build() const;
 
 
 		private:
+			struct HostRange
+			{
+				const void* data;
+				size_t      size;
+			};
+
+
 			const Device& GetDevice() const;
 			size_t GetSize() const;
-			MemoryBlock AllocateMemory(const VkMemoryRequirements& requirements) const;
+			AllocationResult AllocateMemory(const AllocationRequest& request) const;
+			// Allocates memory from the device's allocator when it has run out of the memory that was asked for, first by
+			// evicting resources through the ResidencyManager, and failing that from host visible memory.
+			AllocationResult AllocateUnderPressure(const AllocationRequest& request) const;
+			// Creates the buffer over an import of the host range, if it can be imported.
+			Core::Optional<Buffer> BuildImported(const HostRange& range) const;
 
 
 			mutable Core::Variant<MemoryBlock, MonoAllocator*, PolyAllocator*> mAllocationSource;
 
 
-			Core::Variant<size_t, Core::IO::DynamicByteBuffer> mData {static_cast<size_t>(0)};
+			Core::Variant<size_t, Core::IO::DynamicByteBuffer, HostRange> mData {static_cast<size_t>(0)};
 			size_t mAlignment = 0;
 			VkBufferUsageFlags mUsage = 0;
 			MemoryTypeCriteria mMemoryTypeCriteria;
+			float mPriority = 0.5f;
 		};
 
 
@@ -76,6 +104,11 @@ namespace Strawberry::Vulkan
 		// Overwrite the region of memory mapped to this buffer
 		void SetData(const Core::IO::DynamicByteBuffer& bytes);
 
+		// Makes host writes to the given range of this buffer visible to the device, see MemoryBlock::Flush().
+		void Flush(size_t offset = 0, size_t size = VK_WHOLE_SIZE) const;
+		// Makes device writes to the given range of this buffer visible to the host, see MemoryBlock::Invalidate().
+		void Invalidate(size_t offset = 0, size_t size = VK_WHOLE_SIZE) const;
+
 		// Functions for interpreting buffer data as types.
 		template <typename T> requires (!std::is_pointer_v<T>)
 		T& InterpretAs()  { return *reinterpret_cast<T*>(mMemory.GetMappedAddress()); }
@@ -94,11 +127,16 @@ namespace Strawberry::Vulkan
 		// Returns the size of this buffer.
 		[[nodiscard]] uint64_t GetSize() const;
 
+		// Returns the memory bound to this buffer, e.g. for adding it to a MappedRangeBatch.
+		[[nodiscard]] const MemoryBlock& GetMemory() const;
+
 	private:
-		// Allocate a buffer with the given size and usage from the given allocator.
-		Buffer(VkDevice device, size_t size, VkBufferUsageFlags usage);
+		// Allocate a buffer with the given size and usage from the given allocator, with the given chain of create info.
+		Buffer(VkDevice device, size_t size, VkBufferUsageFlags usage, const void* next = nullptr);
 		// Get the memory requiresments for this buffer.
 		VkMemoryRequirements GetMemoryRequirements(VkDevice device) const;
+		// Get the allocation request for this buffer, which asks for dedicated memory if the driver would prefer it.
+		AllocationRequest GetAllocationRequest(VkDevice device) const;
 
 
 		// The handle for this buffer.
@@ -107,9 +145,7 @@ namespace Strawberry::Vulkan
 		uint64_t                          mSize;
 		// The memory allocated to this buffer.
 		MemoryBlock                        mMemory;
-#ifdef STRAWBERRY_DEBUG
-        // The usage flags for this buffer
-        VkBufferUsageFlags mUsage;
-#endif // STRAWBERRY_DEBUG
+		// The usage flags for this buffer
+		VkBufferUsageFlags                mUsage;
 	};
 }
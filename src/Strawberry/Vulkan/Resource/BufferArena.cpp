@@ -0,0 +1,217 @@
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+#include "Strawberry/Vulkan/Resource/BufferArena.hpp"
+#include "Strawberry/Vulkan/Device/Device.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Assert.hpp"
+// Standard Library
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <utility>
+
+
+//======================================================================================================================
+//  Class Definitions
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	BufferArena::Allocation::Allocation(Allocation&& rhs) noexcept
+		: mArena(std::move(rhs.mArena))
+		, mBuffer(std::exchange(rhs.mBuffer, VK_NULL_HANDLE))
+		, mMemory(std::move(rhs.mMemory))
+		, mSize(std::exchange(rhs.mSize, 0))
+	{}
+
+
+	BufferArena::Allocation& BufferArena::Allocation::operator=(Allocation&& rhs) noexcept
+	{
+		if (this != &rhs)
+		{
+			std::destroy_at(this);
+			std::construct_at(this, std::move(rhs));
+		}
+
+		return *this;
+	}
+
+
+	BufferArena::Allocation::~Allocation()
+	{
+		// The GPU may still be reading this slice, so only give its range back once it has finished. Slices outliving
+		// their arena have nowhere to go back to.
+		if (mMemory && mArena)
+		{
+			mArena->Retire(std::move(mMemory));
+		}
+	}
+
+
+	BufferSlice BufferArena::Allocation::GetSlice() const noexcept
+	{
+		// Chunks are bound to the whole of their pool, so offsets into the buffer and the pool are the same.
+		return {mBuffer, mMemory.Offset(), mSize};
+	}
+
+
+	uint8_t* BufferArena::Allocation::GetData() const noexcept
+	{
+		return mMemory.GetMappedAddress();
+	}
+
+
+	void BufferArena::Allocation::SetData(const Core::IO::DynamicByteBuffer& bytes) const
+	{
+		Core::Assert(bytes.Size() <= mSize);
+		mMemory.Overwrite(bytes);
+	}
+
+
+	BufferArena::Allocation::Allocation(BufferArena& arena, VkBuffer buffer, MemoryBlock&& memory, VkDeviceSize size)
+		: mArena(arena)
+		, mBuffer(buffer)
+		, mMemory(std::move(memory))
+		, mSize(size)
+	{}
+
+
+	BufferArena::BufferArena(Device& device, VkBufferUsageFlags usage, MemoryTypeCriteria memoryTypeCriteria, VkDeviceSize chunkSize)
+		: mDevice(device)
+		, mUsage(usage)
+		, mMemoryTypeCriteria(memoryTypeCriteria)
+		, mChunkSize(chunkSize)
+		, mAlignment(1)
+	{
+		// Offsets of slices are used in place of buffer offsets, so must meet the limits for each kind of binding.
+		const VkPhysicalDeviceLimits& limits = device.GetPhysicalDevice().GetLimits();
+		if (usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)
+		{
+			mAlignment = std::lcm(mAlignment, limits.minUniformBufferOffsetAlignment);
+		}
+		if (usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+		{
+			mAlignment = std::lcm(mAlignment, limits.minStorageBufferOffsetAlignment);
+		}
+		if (usage & (VK_BUFFER_USAGE_UNIFORM_TEXEL_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_TEXEL_BUFFER_BIT))
+		{
+			mAlignment = std::lcm(mAlignment, limits.minTexelBufferOffsetAlignment);
+		}
+		if (usage & VK_BUFFER_USAGE_INDEX_BUFFER_BIT)
+		{
+			// Index buffer offsets must be a multiple of the index size.
+			mAlignment = std::lcm<VkDeviceSize>(mAlignment, sizeof(uint32_t));
+		}
+	}
+
+
+	BufferArena::~BufferArena()
+	{
+		// Like the chunks, retired slices must no longer be in use.
+		mRetired.clear();
+		for (Chunk& chunk : mChunks)
+		{
+			vkDestroyBuffer(mDevice->Handle(), chunk.buffer, nullptr);
+		}
+	}
+
+
+	BufferArena::Allocation BufferArena::Allocate(VkDeviceSize size, VkDeviceSize alignment)
+	{
+		ZoneScoped;
+
+		Reclaim();
+
+		const AllocationRequest request = AllocationRequest(size, std::lcm(std::max<VkDeviceSize>(alignment, 1), mAlignment))
+			.WithResourceKind(ResourceKind::Linear);
+
+		// Prefer the newest chunks, which are the most likely to have space.
+		for (auto chunk = mChunks.rbegin(); chunk != mChunks.rend(); ++chunk)
+		{
+			if (AllocationResult result = chunk->allocator->Allocate(request))
+			{
+				return Allocation(*this, chunk->buffer, result.Unwrap(), size);
+			}
+		}
+
+		Chunk& chunk = AddChunk(std::max(mChunkSize, size + request.alignment));
+		return Allocation(*this, chunk.buffer, chunk.allocator->Allocate(request).Unwrap(), size);
+	}
+
+
+	BufferArena::Allocation BufferArena::Allocate(const Core::IO::DynamicByteBuffer& bytes, VkDeviceSize alignment)
+	{
+		Allocation allocation = Allocate(bytes.Size(), alignment);
+		allocation.SetData(bytes);
+		return allocation;
+	}
+
+
+	void BufferArena::Reclaim()
+	{
+		const uint64_t completed = mDevice->CompletedSubmission();
+		while (!mRetired.empty() && mRetired.front().submission <= completed)
+		{
+			mRetired.pop_front();
+		}
+	}
+
+
+	void BufferArena::Retire(MemoryBlock&& memory)
+	{
+		mRetired.emplace_back(Retired{.submission = mDevice->LastSubmission(), .memory = std::move(memory)});
+	}
+
+
+	BufferArena::Chunk& BufferArena::AddChunk(VkDeviceSize size)
+	{
+		ZoneScoped;
+
+		VkBuffer buffer = CreateBuffer(size);
+		VkMemoryRequirements requirements;
+		vkGetBufferMemoryRequirements(mDevice->Handle(), buffer, &requirements);
+
+		// The allocator hands out the whole pool, so the buffer must cover all of it.
+		if (requirements.size > size)
+		{
+			vkDestroyBuffer(mDevice->Handle(), buffer, nullptr);
+			buffer = CreateBuffer(requirements.size);
+			vkGetBufferMemoryRequirements(mDevice->Handle(), buffer, &requirements);
+		}
+
+		// Take the most preferred memory type that the buffer can live in.
+		const auto memoryTypes = mDevice->GetPhysicalDevice().SearchMemoryTypes(mMemoryTypeCriteria);
+		auto memoryType = std::ranges::find_if(memoryTypes, [&](const MemoryType& type)
+		{
+			return requirements.memoryTypeBits & (1 << type.index.memoryTypeIndex);
+		});
+		Core::Assert(memoryType != memoryTypes.end());
+
+		MemoryPool pool = MemoryPool::Allocate(*mDevice, memoryType->index, requirements.size).Unwrap();
+		Core::AssertEQ(vkBindBufferMemory(mDevice->Handle(), buffer, pool.Memory(), 0), VK_SUCCESS);
+
+		return mChunks.emplace_back(Chunk{
+			.buffer = buffer,
+			.allocator = std::make_unique<TLSFAllocator>(std::move(pool))
+		});
+	}
+
+
+	VkBuffer BufferArena::CreateBuffer(VkDeviceSize size) const
+	{
+		const VkBufferCreateInfo createInfo{
+			.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.size = size,
+			.usage = mUsage,
+			.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
+			.queueFamilyIndexCount = 0,
+			.pQueueFamilyIndices = nullptr,
+		};
+
+		VkBuffer buffer = VK_NULL_HANDLE;
+		Core::AssertEQ(vkCreateBuffer(mDevice->Handle(), &createInfo, nullptr, &buffer), VK_SUCCESS);
+		return buffer;
+	}
+}
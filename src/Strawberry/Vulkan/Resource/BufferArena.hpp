@@ -0,0 +1,141 @@
+#pragma once
+
+
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+// Strawberry Vulkan
+#include "Strawberry/Vulkan/Memory/Allocator/TLSFAllocator.hpp"
+#include "Strawberry/Vulkan/Memory/MemoryTypeCriteria.hpp"
+#include "Strawberry/Vulkan/Resource/BufferSlice.hpp"
+// Strawberry Core
+#include "Strawberry/Core/IO/DynamicByteBuffer.hpp"
+#include "Strawberry/Core/Types/ReflexivePointer.hpp"
+// Vulkan
+#include <vulkan/vulkan.h>
+// Standard Library
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+
+//======================================================================================================================
+//  Class Declaration
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	class Device;
+
+
+	// Packs many small buffers, such as meshes and uniform buffers, into a few large VkBuffers.
+	//
+	// Each chunk of the arena is one VkBuffer bound to the whole of its own memory pool, which a TLSFAllocator carves
+	// into slices. Slices share their chunk's handle and are told apart by offset, so creating one costs no Vulkan
+	// calls, and consecutive draws from the same chunk do not need their buffers rebinding.
+	//
+	// Like other allocators, an arena must outlive any GPU work that uses its slices, and is not thread safe.
+	class BufferArena
+		: public Core::EnableReflexivePointer
+	{
+	public:
+		// An owned slice of the arena. Its range is returned to the arena once the GPU is done with it, which the arena
+		// checks for whenever it allocates.
+		class Allocation
+		{
+		public:
+			Allocation() = default;
+			Allocation(const Allocation&)            = delete;
+			Allocation& operator=(const Allocation&) = delete;
+			Allocation(Allocation&& rhs) noexcept;
+			Allocation& operator=(Allocation&& rhs) noexcept;
+			~Allocation();
+
+
+			explicit operator bool() const noexcept { return static_cast<bool>(mMemory); }
+
+			// Allocations can be used anywhere a slice can.
+			operator BufferSlice() const noexcept { return GetSlice(); }
+			[[nodiscard]] BufferSlice GetSlice() const noexcept;
+
+
+			// Returns the mapped address of this slice. The arena's memory must be host visible.
+			[[nodiscard]] uint8_t* GetData() const noexcept;
+			// Copies the given bytes to the start of this slice and flushes them.
+			void SetData(const Core::IO::DynamicByteBuffer& bytes) const;
+
+
+		private:
+			friend class BufferArena;
+			Allocation(BufferArena& arena, VkBuffer buffer, MemoryBlock&& memory, VkDeviceSize size);
+
+
+			Core::ReflexivePointer<BufferArena> mArena;
+			VkBuffer                            mBuffer = VK_NULL_HANDLE;
+			MemoryBlock                         mMemory;
+			VkDeviceSize                        mSize   = 0;
+		};
+
+
+		// Creates an arena for buffers with the given usage, in chunks of the given size. Allocations larger than a
+		// chunk are given a chunk of their own.
+		BufferArena(Device& device, VkBufferUsageFlags usage, MemoryTypeCriteria memoryTypeCriteria, VkDeviceSize chunkSize = 64 * 1024 * 1024);
+		BufferArena(const BufferArena&)            = delete;
+		BufferArena& operator=(const BufferArena&) = delete;
+		~BufferArena();
+
+
+		// Allocates a slice of at least the given size, aligned to both the given alignment and whatever alignment
+		// the arena's usage requires, e.g. minUniformBufferOffsetAlignment. Slices whose last use has completed are
+		// returned to the arena first.
+		[[nodiscard]] Allocation Allocate(VkDeviceSize size, VkDeviceSize alignment = 1);
+		// Allocates a slice holding the given bytes. The arena's memory must be host visible.
+		[[nodiscard]] Allocation Allocate(const Core::IO::DynamicByteBuffer& bytes, VkDeviceSize alignment = 1);
+
+
+		// Returns the slices of dropped allocations whose last use has completed to the arena.
+		void Reclaim();
+
+
+		// Returns the number of chunks, and so VkBuffers, that this arena has created.
+		[[nodiscard]] size_t ChunkCount() const noexcept { return mChunks.size(); }
+
+
+	private:
+		struct Chunk
+		{
+			VkBuffer                       buffer;
+			std::unique_ptr<TLSFAllocator> allocator;
+		};
+
+
+		struct Retired
+		{
+			// The last submission which may have used the slice.
+			uint64_t    submission;
+			MemoryBlock memory;
+		};
+
+
+		// Holds on to the slice of a dropped allocation until the GPU is done with it. Slices are freed here, rather
+		// than through the DeferredReleaseQueue, so that the chunks' allocators are only ever used by the arena's thread.
+		void Retire(MemoryBlock&& memory);
+
+
+		// Creates a chunk able to hold at least the given number of bytes.
+		Chunk& AddChunk(VkDeviceSize size);
+		// Creates a buffer of the arena's usage.
+		VkBuffer CreateBuffer(VkDeviceSize size) const;
+
+
+		Core::ReflexivePointer<Device> mDevice;
+		VkBufferUsageFlags             mUsage;
+		MemoryTypeCriteria             mMemoryTypeCriteria;
+		VkDeviceSize                   mChunkSize;
+		// The alignment that every slice is given, from the usage's offset alignment limits.
+		VkDeviceSize                   mAlignment;
+		std::vector<Chunk>             mChunks;
+		// Slices of dropped allocations, oldest first.
+		std::deque<Retired>            mRetired;
+	};
+}
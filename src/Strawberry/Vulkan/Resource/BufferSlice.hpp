@@ -0,0 +1,54 @@
+#pragma once
+
+
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+// Strawberry Vulkan
+#include "Strawberry/Vulkan/Resource/Buffer.hpp"
+// Vulkan
+#include <vulkan/vulkan.h>
+
+
+//======================================================================================================================
+//  Class Declaration
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	// A range of a buffer, which can be bound or written to descriptors in place of a whole buffer. Slices do not own
+	// the buffer they view. See BufferArena for packing many small buffers into a few large ones.
+	struct BufferSlice
+	{
+		BufferSlice(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize size)
+			: buffer(buffer)
+			, offset(offset)
+			, size(size)
+		{}
+
+		// Views the whole of the given buffer.
+		BufferSlice(const Buffer& buffer)
+			: BufferSlice(buffer, 0, buffer.GetSize())
+		{}
+
+		// Views part of the given buffer.
+		BufferSlice(const Buffer& buffer, VkDeviceSize offset, VkDeviceSize size)
+			: BufferSlice(static_cast<VkBuffer>(buffer), offset, size)
+		{}
+
+
+		bool operator==(const BufferSlice&) const = default;
+		bool operator!=(const BufferSlice&) const = default;
+
+
+		// Returns the given range of this slice, relative to its start.
+		BufferSlice Subslice(VkDeviceSize subOffset, VkDeviceSize subSize) const
+		{
+			return {buffer, offset + subOffset, subSize};
+		}
+
+
+		VkBuffer     buffer;
+		VkDeviceSize offset;
+		VkDeviceSize size;
+	};
+}
@@ -17,21 +17,36 @@
 //----------------------------------------------------------------------------------------------------------------------
 namespace Strawberry::Vulkan
 {
-	Framebuffer::Framebuffer(RenderPass& renderPass, Core::Math::Vec2u size, VkSampleCountFlagBits samples)
+	Framebuffer::Framebuffer(RenderPass& renderPass, Core::Math::Vec2u size, VkSampleCountFlagBits samples, TransientAttachmentPool* transientPool)
 		: mRenderPass(renderPass)
 		, mSize(size)
 	{
 		const auto ATTACHMENT_COUNT = mRenderPass->mAttachmentFormats.size();
-		for (int i = 0; i < ATTACHMENT_COUNT; i++)
+
+		std::vector<Core::Optional<Image>> images(ATTACHMENT_COUNT);
+		if (renderPass.GetTransientSlotCount() > 0)
 		{
-			Image image = Image::Builder(renderPass.GetDevice(), MemoryTypeCriteria::DeviceLocal())
-				.WithExtent(mSize)
-				.WithFormat(renderPass.mAttachmentFormats[i])
-				.WithUsage(renderPass.mAttachmentUsages[i])
-				.WithSamples(samples)
-				.Build();
+			if (!transientPool)
+			{
+				mOwnTransientPool = std::make_unique<TransientAttachmentPool>(renderPass.GetDevice());
+				transientPool = mOwnTransientPool.get();
+			}
+			CreateTransientAttachments(*transientPool, samples, images);
+		}
 
-			mAttachments.emplace_back(std::move(image));
+		for (int i = 0; i < ATTACHMENT_COUNT; i++)
+		{
+			if (!images[i])
+			{
+				images[i] = Image::Builder(renderPass.GetDevice(), MemoryTypeCriteria::DeviceLocal())
+					.WithExtent(mSize)
+					.WithFormat(renderPass.mAttachmentFormats[i])
+					.WithUsage(renderPass.mAttachmentUsages[i])
+					.WithSamples(samples)
+					.Build();
+			}
+
+			mAttachments.emplace_back(images[i].Unwrap());
 
 			VkImageAspectFlags aspectFlags = mRenderPass->mAttachmentAspectFlags[i];
 			VkImageLayout initialLayout = mRenderPass->mInitialLayouts[i];
@@ -72,6 +87,7 @@ namespace Strawberry::Vulkan
 		: mFramebuffer(std::exchange(rhs.mFramebuffer, nullptr))
 		  , mRenderPass(std::move(rhs.mRenderPass))
 		  , mSize(std::exchange(rhs.mSize, Core::Math::Vec2u()))
+		  , mOwnTransientPool(std::move(rhs.mOwnTransientPool))
 		  , mAttachments(std::move(rhs.mAttachments))
 		  , mAttachmentViews(std::move(rhs.mAttachmentViews))
 	{
@@ -141,4 +157,53 @@ namespace Strawberry::Vulkan
 	{
 		return mAttachments[index];
 	}
+
+
+	void Framebuffer::CreateTransientAttachments(TransientAttachmentPool& pool, VkSampleCountFlagBits samples, std::vector<Core::Optional<Image>>& images)
+	{
+		ZoneScoped;
+
+		RenderPass& renderPass = *mRenderPass;
+		const auto configure = [&](Image::Builder&& builder, uint32_t attachment)
+		{
+			return std::move(builder)
+				.WithExtent(mSize)
+				.WithFormat(renderPass.mAttachmentFormats[attachment])
+				.WithUsage(renderPass.mAttachmentUsages[attachment] | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT)
+				.WithSamples(samples);
+		};
+
+
+		// Every attachment in a slot starts at the beginning of the slot's memory, so the memory must meet the
+		// requirements of all of them at once.
+		std::vector<Core::Optional<VkMemoryRequirements>> slotRequirements(renderPass.GetTransientSlotCount());
+		for (uint32_t i = 0; i < images.size(); i++)
+		{
+			if (!renderPass.IsTransientAttachment(i)) continue;
+
+			const VkMemoryRequirements requirements =
+				configure(Image::Builder(renderPass.GetDevice(), MemoryTypeCriteria::Transient()), i).QueryMemoryRequirements();
+
+			Core::Optional<VkMemoryRequirements>& slot = slotRequirements[renderPass.GetTransientSlot(i)];
+			if (!slot)
+			{
+				slot = requirements;
+				continue;
+			}
+
+			slot->size           = std::max(slot->size, requirements.size);
+			slot->alignment      = std::max(slot->alignment, requirements.alignment);
+			slot->memoryTypeBits = slot->memoryTypeBits & requirements.memoryTypeBits;
+			Core::Assert(slot->memoryTypeBits != 0);
+		}
+
+
+		for (uint32_t i = 0; i < images.size(); i++)
+		{
+			if (!renderPass.IsTransientAttachment(i)) continue;
+
+			const uint32_t slot = renderPass.GetTransientSlot(i);
+			images[i] = configure(Image::Builder(&pool.Acquire(slot, *slotRequirements[slot])), i).Build();
+		}
+	}
 }
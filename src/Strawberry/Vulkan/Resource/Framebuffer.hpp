@@ -6,12 +6,15 @@
 //----------------------------------------------------------------------------------------------------------------------
 #include "Strawberry/Vulkan/Resource/Image.hpp"
 #include "Strawberry/Vulkan/Resource/ImageView.hpp"
+#include "Strawberry/Vulkan/Resource/TransientAttachmentPool.hpp"
 // Vulkan
 #include <vulkan/vulkan.h>
 // Strawberry Core
 #include "Strawberry/Core/Math/Vector.hpp"
+#include "Strawberry/Core/Types/Optional.hpp"
 #include "Strawberry/Core/Types/ReflexivePointer.hpp"
 // Standard Library
+#include <memory>
 #include <vector>
 
 
@@ -32,7 +35,10 @@ namespace Strawberry::Vulkan
 
 
 	public:
-		Framebuffer(RenderPass& mRenderPass, Core::Math::Vec2u size, VkSampleCountFlagBits = VK_SAMPLE_COUNT_1_BIT);
+		// Creates a framebuffer with new attachments for the given render pass. Attachments whose contents never leave
+		// the render pass are created as transient attachments in memory from the given pool, or from a pool of the
+		// framebuffer's own if none is given.
+		Framebuffer(RenderPass& mRenderPass, Core::Math::Vec2u size, VkSampleCountFlagBits = VK_SAMPLE_COUNT_1_BIT, TransientAttachmentPool* transientPool = nullptr);
 		Framebuffer(const Framebuffer& rhs)            = delete;
 		Framebuffer& operator=(const Framebuffer& rhs) = delete;
 		Framebuffer(Framebuffer&& rhs) noexcept;
@@ -56,10 +62,8 @@ namespace Strawberry::Vulkan
 		Image&                 GetAttachment(uint32_t index);
 
 	private:
-		Image     CreateDepthImage(const Device& device, Allocator& allocator);
-		ImageView CreateDepthImageView();
-		Image     CreateStencilImage(const Device& device, Allocator& allocator);
-		ImageView CreateStencilImageView();
+		// Creates the transient attachments of the render pass in memory from the given pool.
+		void CreateTransientAttachments(TransientAttachmentPool& pool, VkSampleCountFlagBits samples, std::vector<Core::Optional<Image>>& images);
 
 
 		VkFramebuffer                      mFramebuffer;
@@ -67,6 +71,10 @@ namespace Strawberry::Vulkan
 		Core::Math::Vec2u                  mSize;
 
 
+		// The pool of transient attachment memory made for this framebuffer, when it was not given a shared one.
+		std::unique_ptr<TransientAttachmentPool> mOwnTransientPool;
+
+
 		std::vector<Image>     mAttachments;
 		std::vector<ImageView> mAttachmentViews;
 	};
@@ -3,6 +3,7 @@
 //----------------------------------------------------------------------------------------------------------------------
 #include "Strawberry/Vulkan/Resource/Image.hpp"
 #include "Strawberry/Vulkan/Device/Device.hpp"
+#include "Strawberry/Vulkan/Memory/DeferredReleaseQueue.hpp"
 #include "Strawberry/Vulkan/Queue/CommandBuffer.hpp"
 #include "Strawberry/Vulkan/Resource/Buffer.hpp"
 // Strawberry Core
@@ -99,6 +100,84 @@ namespace Strawberry::Vulkan
 	{
 		const Device& device = GetDevice();
 
+		VkImage imageHandle = CreateImage();
+
+
+		const VkImageMemoryRequirementsInfo2 requirementsInfo
+		{
+			.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2,
+			.pNext = nullptr,
+			.image = imageHandle,
+		};
+		VkMemoryDedicatedRequirements dedicatedRequirements
+		{
+			.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS,
+			.pNext = nullptr,
+		};
+		VkMemoryRequirements2 memoryRequirements
+		{
+			.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2,
+			.pNext = &dedicatedRequirements,
+		};
+		vkGetImageMemoryRequirements2(device.Handle(), &requirementsInfo, &memoryRequirements);
+
+		if (mAllocationSource.IsType<const MemoryBlock*>())
+		{
+			const VkMemoryRequirements& requirements = memoryRequirements.memoryRequirements;
+			const MemoryBlock& memory = *mAllocationSource.Ref<const MemoryBlock*>();
+			Core::Assert(requirements.size <= memory.Size());
+			Core::AssertEQ(memory.Offset() % requirements.alignment, 0);
+			Core::Assert(requirements.memoryTypeBits & (1 << memory.GetMemoryPool()->GetMemoryTypeIndex().memoryTypeIndex));
+			Core::AssertEQ(vkBindImageMemory(device.Handle(), imageHandle, memory.Memory(), memory.Offset()), VK_SUCCESS);
+
+			Image image(device, imageHandle, mExtent.Value(), mFormat.Value());
+			image.mSamples = mSamples;
+			image.mArrayLayerCount = static_cast<uint32_t>(mArrayLayers);
+			return image;
+		}
+
+		// Give the image memory of its own if the driver asks, so that it can use faster paths for it.
+		AllocationRequest request(memoryRequirements.memoryRequirements);
+		request.WithResourceKind(mTiling == VK_IMAGE_TILING_LINEAR ? ResourceKind::Linear : ResourceKind::Optimal);
+		if (dedicatedRequirements.prefersDedicatedAllocation || dedicatedRequirements.requiresDedicatedAllocation)
+		{
+			request.WithDedicatedImage(imageHandle, dedicatedRequirements.requiresDedicatedAllocation);
+		}
+
+		MemoryBlock memory = mAllocationSource.Visit(
+			[&](MemoryBlock& allocation) { return AllocationResult(std::move(allocation)); },
+			[&](MonoAllocator* allocator) { return allocator->Allocate(request); },
+			[&](PolyAllocator* allocator) { return allocator->Allocate(request, mMemoryTypeCriteria); },
+			[&](const MemoryBlock*) -> AllocationResult { Core::Unreachable(); }
+		).Unwrap();
+
+		Core::AssertEQ(vkBindImageMemory(device.Handle(), imageHandle, memory.Memory(), memory.Offset()), VK_SUCCESS);
+
+
+		Image image(imageHandle, std::move(memory), mExtent.Value(), mFormat.Value());
+		image.mSamples = mSamples;
+		image.mArrayLayerCount = static_cast<uint32_t>(mArrayLayers);
+		return image;
+	}
+
+
+	VkMemoryRequirements Image::Builder::QueryMemoryRequirements() const
+	{
+		const Device& device = GetDevice();
+
+		// Vulkan 1.2 can only report requirements for an image that exists, so create one just to ask.
+		VkImage imageHandle = CreateImage();
+		VkMemoryRequirements requirements;
+		vkGetImageMemoryRequirements(device.Handle(), imageHandle, &requirements);
+		vkDestroyImage(device.Handle(), imageHandle, nullptr);
+		return requirements;
+	}
+
+
+	VkImage Image::Builder::CreateImage() const
+	{
+		const Device& device = GetDevice();
+
 		VkImage imageHandle = VK_NULL_HANDLE;
 
 		VkImageCreateInfo createInfo{
@@ -123,25 +202,10 @@ namespace Strawberry::Vulkan
 			.initialLayout = mInitialLayout
 		};
 		Core::AssertEQ(vkCreateImage(device.Handle(), &createInfo, nullptr, &imageHandle), VK_SUCCESS);
-
-
-		VkMemoryRequirements memoryRequirements;
-		vkGetImageMemoryRequirements(device.Handle(), imageHandle, &memoryRequirements);
-		MemoryBlock memory = mAllocationSource.Visit(
-			[&](MemoryBlock& allocation) { return AllocationResult(std::move(allocation)); },
-			[&](MonoAllocator* allocator) { return allocator->Allocate(memoryRequirements); },
-			[&](PolyAllocator* allocator) { return allocator->Allocate(memoryRequirements, mMemoryTypeCriteria); }
-		).Unwrap();
-
-		Core::AssertEQ(vkBindImageMemory(device.Handle(), imageHandle, memory.Memory(), memory.Offset()), VK_SUCCESS);
-
-
-		Image image(imageHandle, std::move(memory), mExtent.Value(), mFormat.Value());
-		image.mSamples = mSamples;
-		image.mArrayLayerCount = static_cast<uint32_t>(mArrayLayers);
-		return image;
+		return imageHandle;
 	}
 
+
 	const Device& Image::Builder::GetDevice() const
 	{
 		return mAllocationSource.Visit(
@@ -156,6 +220,10 @@ namespace Strawberry::Vulkan
 			[&](const PolyAllocator* allocator) -> const Device&
 			{
 				return allocator->GetDevice();
+			},
+			[&](const MemoryBlock* aliasedMemory) -> const Device&
+			{
+				return aliasedMemory->GetDevice();
 			}
 		);
 	}
@@ -177,7 +245,8 @@ namespace Strawberry::Vulkan
 	{
 		if (mImage)
 		{
-			vkDestroyImage(GetDevice().Handle(), mImage, nullptr);
+			// The GPU may still be using this image, so leave it to be destroyed once it has finished.
+			mDevice->GetDeferredReleases().ReleaseImage(mImage, std::move(mMemory));
 		}
 	}
 
@@ -190,7 +259,7 @@ namespace Strawberry::Vulkan
 
 	const Device& Image::GetDevice() const
 	{
-		return mMemory.GetDevice();
+		return *mDevice;
 	}
 
 	VkFormat Image::GetFormat() const
@@ -218,22 +287,27 @@ namespace Strawberry::Vulkan
 
 
 	Image::Image(VkImage imageHandle, MemoryBlock &&allocation, Core::Math::Vec3u extent, VkFormat format)
-		: mImage(imageHandle)
+		: mDevice(allocation.GetDevice())
+		, mImage(imageHandle)
 		, mMemory(std::move(allocation))
 		, mFormat(format)
 		, mExtent(extent)
 	{}
 
-	Image::Image(VkImage imageHandle, Core::Math::Vec3u extent, VkFormat format)
-		: mImage(imageHandle)
+	Image::Image(const Device& device, VkImage imageHandle, Core::Math::Vec3u extent, VkFormat format)
+		: mDevice(device)
+		, mImage(imageHandle)
 		, mFormat(format)
 		, mExtent(extent) {}
 
 
 	Image::Image(Image&& rhs) noexcept
 		: EnableReflexivePointer(std::move(rhs))
+		, mDevice(std::move(rhs.mDevice))
 		, mImage(std::exchange(rhs.mImage, nullptr))
 		, mMemory(std::move(rhs.mMemory))
 		, mFormat(std::exchange(rhs.mFormat, VK_FORMAT_MAX_ENUM))
-		, mExtent(std::exchange(rhs.mExtent, Core::Math::Vec3u())) {}
+		, mExtent(std::exchange(rhs.mExtent, Core::Math::Vec3u()))
+		, mSamples(rhs.mSamples)
+		, mArrayLayerCount(rhs.mArrayLayerCount) {}
 }
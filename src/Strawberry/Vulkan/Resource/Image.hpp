@@ -43,6 +43,7 @@ namespace Strawberry::Vulkan
 				: mAllocationSource(std::move(allocation)) {}
 
 
+			// See Buffer::Builder(MonoAllocator&) for when the memory of images built this way is freed.
 			Builder(MonoAllocator& allocator)
 				: mAllocationSource(&allocator) {}
 
@@ -52,6 +53,12 @@ namespace Strawberry::Vulkan
 				  , mMemoryTypeCriteria(memoryTypeCriteria) {}
 
 
+			// Binds the image to the start of memory which is owned elsewhere, so that several images can alias it.
+			// The memory must outlive the image, and be large and aligned enough for it.
+			explicit Builder(const MemoryBlock* aliasedMemory)
+				: mAllocationSource(aliasedMemory) {}
+
+
 			Builder&& WithExtent(unsigned extent);
 
 			Builder&& WithExtent(Core::Math::Vec2u extent);
@@ -75,12 +82,18 @@ namespace Strawberry::Vulkan
 
 			Image Build();
 
+
+			// Returns the memory requirements of the image that would be built, without building it. Used to size
+			// memory shared between images before any of them are bound to it.
+			[[nodiscard]] VkMemoryRequirements QueryMemoryRequirements() const;
+
 		private:
 			const Device& GetDevice() const;
+			VkImage CreateImage() const;
 
 
-			mutable Core::Variant<MemoryBlock, MonoAllocator*, PolyAllocator*> mAllocationSource;
-			MemoryTypeCriteria                                                   mMemoryTypeCriteria;
+			mutable Core::Variant<MemoryBlock, MonoAllocator*, PolyAllocator*, const MemoryBlock*> mAllocationSource;
+			MemoryTypeCriteria                                                                       mMemoryTypeCriteria;
 
 
 			Core::Optional<VkImageType>       mImageType;
@@ -138,12 +151,15 @@ namespace Strawberry::Vulkan
 			  Core::Math::Vec3u extent,
 			  VkFormat          format);
 
-		Image(VkImage           imageHandle,
+		Image(const Device&     device,
+			  VkImage           imageHandle,
 			  Core::Math::Vec3u extent,
 			  VkFormat          format);
 
 
+		Core::ReflexivePointer<const Device> mDevice;
 		VkImage           mImage;
+		// Empty for swapchain images and images bound to aliased memory, which do not own their memory.
 		MemoryBlock        mMemory;
 		VkFormat          mFormat;
 		Core::Math::Vec3u mExtent;
@@ -0,0 +1,79 @@
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+#include "Strawberry/Vulkan/Resource/TransientAttachmentPool.hpp"
+#include "Strawberry/Vulkan/Device/Device.hpp"
+#include "Strawberry/Vulkan/Memory/DeferredReleaseQueue.hpp"
+#include "Strawberry/Vulkan/Memory/MemoryPool.hpp"
+#include "Strawberry/Vulkan/Memory/MemoryTypeCriteria.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/PolyAllocator.hpp"
+// Standard Library
+#include <algorithm>
+#include <utility>
+
+
+//======================================================================================================================
+//  Class Definitions
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	TransientAttachmentPool::TransientAttachmentPool(Device& device)
+		: mDevice(device)
+	{}
+
+
+	TransientAttachmentPool::~TransientAttachmentPool()
+	{
+		// Attachments bound to these blocks may still be in use by the GPU.
+		for (MemoryBlock& block : mSlots)
+		{
+			if (block) mDevice->GetDeferredReleases().ReleaseMemory(std::move(block));
+		}
+		for (MemoryBlock& block : mReplaced)
+		{
+			mDevice->GetDeferredReleases().ReleaseMemory(std::move(block));
+		}
+	}
+
+
+	const MemoryBlock& TransientAttachmentPool::Acquire(uint32_t slot, const VkMemoryRequirements& requirements)
+	{
+		ZoneScoped;
+
+		if (slot >= mSlots.size())
+		{
+			mSlots.resize(slot + 1);
+		}
+
+		MemoryBlock& block = mSlots[slot];
+		const bool fits = block
+			&& block.Size() >= requirements.size
+			&& block.Offset() % requirements.alignment == 0
+			&& requirements.memoryTypeBits & (1 << block.GetMemoryPool()->GetMemoryTypeIndex().memoryTypeIndex);
+		if (fits)
+		{
+			return block;
+		}
+
+		// Grow to the larger of the old and new sizes, so that the slot settles on the largest attachment placed in it.
+		VkMemoryRequirements grown = requirements;
+		if (block)
+		{
+			grown.size = std::max<VkDeviceSize>(grown.size, block.Size());
+			mReplaced.emplace_back(std::move(block));
+		}
+
+		const AllocationRequest request = AllocationRequest(grown).WithResourceKind(ResourceKind::Optimal);
+		block = mDevice->GetAllocator().Allocate(request, MemoryTypeCriteria::Transient()).Unwrap();
+		return block;
+	}
+
+
+	size_t TransientAttachmentPool::Size() const noexcept
+	{
+		size_t size = 0;
+		for (const MemoryBlock& block : mSlots) size += block.Size();
+		for (const MemoryBlock& block : mReplaced) size += block.Size();
+		return size;
+	}
+}
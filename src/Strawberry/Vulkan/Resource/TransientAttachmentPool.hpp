@@ -0,0 +1,59 @@
+#pragma once
+
+
+//======================================================================================================================
+//  Includes
+//----------------------------------------------------------------------------------------------------------------------
+// Strawberry Vulkan
+#include "Strawberry/Vulkan/Memory/MemoryBlock.hpp"
+// Strawberry Core
+#include "Strawberry/Core/Types/ReflexivePointer.hpp"
+// Vulkan
+#include <vulkan/vulkan.h>
+// Standard Library
+#include <vector>
+
+
+//======================================================================================================================
+//  Class Declaration
+//----------------------------------------------------------------------------------------------------------------------
+namespace Strawberry::Vulkan
+{
+	class Device;
+
+
+	// Memory for the transient attachments of framebuffers, such as depth buffers and multisampled colour buffers,
+	// whose contents never leave their render pass.
+	//
+	// The pool keeps one block of memory per slot, which the render pass assigns to its transient attachments, see
+	// RenderPass::GetTransientSlot(). Each framebuffer binds its attachments in a slot to the start of that slot's
+	// block, so that attachments of one framebuffer which are used in different subpasses share memory, and so do the
+	// attachments of every framebuffer which shares the pool. Framebuffers sharing a pool must therefore never be
+	// rendered to at the same time, e.g. offscreen passes recorded one after another with barriers between them.
+	//
+	// A pool must outlive the framebuffers using it, and is not thread safe.
+	class TransientAttachmentPool
+	{
+	public:
+		explicit TransientAttachmentPool(Device& device);
+		TransientAttachmentPool(const TransientAttachmentPool&)            = delete;
+		TransientAttachmentPool& operator=(const TransientAttachmentPool&) = delete;
+		~TransientAttachmentPool();
+
+
+		// Returns the block of the given slot, replacing it with one which meets the given requirements if it does
+		// not already. Attachments bound to a replaced block keep it alive until the pool is destroyed.
+		[[nodiscard]] const MemoryBlock& Acquire(uint32_t slot, const VkMemoryRequirements& requirements);
+
+
+		// Returns the number of bytes held by the pool, including replaced blocks.
+		[[nodiscard]] size_t Size() const noexcept;
+
+
+	private:
+		Core::ReflexivePointer<Device> mDevice;
+		std::vector<MemoryBlock>       mSlots;
+		// Blocks which have been outgrown, but may still be bound to attachments.
+		std::vector<MemoryBlock>       mReplaced;
+	};
+}
@@ -26,8 +26,10 @@ namespace Strawberry::Vulkan
 
 
 	Fence::Fence(Fence&& rhs) noexcept
-		: mFence(std::exchange(rhs.mFence, nullptr))
-		  , mDevice(std::exchange(rhs.mDevice, nullptr)) {}
+		: EnableReflexivePointer(std::move(rhs))
+		  , mFence(std::exchange(rhs.mFence, nullptr))
+		  , mDevice(std::exchange(rhs.mDevice, nullptr))
+		  , mResetCount(rhs.mResetCount.exchange(0)) {}
 
 
 	Fence& Fence::operator=(Fence&& rhs) noexcept
@@ -78,5 +80,6 @@ namespace Strawberry::Vulkan
 	{
 		ZoneScoped;
 		Core::AssertEQ(vkResetFences(mDevice, 1, &mFence), VK_SUCCESS);
+		mResetCount++;
 	}
 }
@@ -4,8 +4,13 @@
 //======================================================================================================================
 //  Includes
 //----------------------------------------------------------------------------------------------------------------------
+// Strawberry Core
+#include "Strawberry/Core/Types/ReflexivePointer.hpp"
 // Vulkan
 #include <vulkan/vulkan.h>
+// Standard Library
+#include <atomic>
+#include <cstdint>
 
 
 //======================================================================================================================
@@ -17,6 +22,7 @@ namespace Strawberry::Vulkan
 
 
 	class Fence
+			: public Core::EnableReflexivePointer
 	{
 		friend class Swapchain;
 		friend class CommandBuffer;
@@ -32,6 +38,8 @@ namespace Strawberry::Vulkan
 
 
 		[[nodiscard]] bool Signaled() const noexcept;
+		// Returns the number of times the fence has been reset. May be read on any thread.
+		[[nodiscard]] uint64_t ResetCount() const noexcept { return mResetCount; }
 
 
 		void Wait();
@@ -40,5 +48,6 @@ namespace Strawberry::Vulkan
 	private:
 		VkFence  mFence;
 		VkDevice mDevice;
+		std::atomic<uint64_t> mResetCount = 0;
 	};
 }
@@ -0,0 +1,468 @@
+#include "Strawberry/Vulkan/Device/Device.hpp"
+#include "Strawberry/Vulkan/Device/Instance.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/BuddyAllocator.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/ConcurrentPolyAllocator.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/FallbackAllocator.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/FreelistAllocator.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/NaivePolyAllocator.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/PolyAllocator.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/TLSFAllocator.hpp"
+#include "Strawberry/Vulkan/Memory/Defragmenter.hpp"
+#include "Strawberry/Vulkan/Queue/CommandPool.hpp"
+#include "Strawberry/Vulkan/Queue/Queue.hpp"
+#include "Strawberry/Vulkan/Resource/Buffer.hpp"
+#include "Strawberry/Core/Assert.hpp"
+#include "GLFW/glfw3.h"
+#include <chrono>
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+
+using namespace Strawberry;
+using namespace Vulkan;
+
+
+// Size of the memory pool each allocator under test manages.
+static constexpr size_t POOL_SIZE = 256 * 1024 * 1024;
+
+
+// A single step of a benchmark workload.
+struct Operation
+{
+	enum class Kind { Allocate, Free };
+
+	Kind   kind;
+	// The slot of the live allocation table this operation acts upon.
+	size_t slot;
+	size_t size;
+	size_t alignment;
+};
+
+
+// Generates a deterministic workload of interleaved allocations and frees of mixed sizes, which keeps up to
+// `liveCount` allocations alive at once so that the pool becomes progressively more fragmented.
+std::vector<Operation> GenerateChurn(size_t operationCount, size_t liveCount, unsigned seed = 0x5EED)
+{
+	std::mt19937                          random(seed);
+	std::uniform_int_distribution<size_t> sizeDistribution(256, 64 * 1024);
+	std::uniform_int_distribution<int>    alignmentDistribution(8, 12);
+
+	std::vector<Operation> operations;
+	operations.reserve(operationCount);
+
+	std::vector<size_t> freeSlots(liveCount);
+	std::vector<size_t> usedSlots;
+	for (size_t i = 0; i < liveCount; i++) freeSlots[i] = liveCount - i - 1;
+
+	for (size_t i = 0; i < operationCount; i++)
+	{
+		const bool allocate = usedSlots.empty() || (!freeSlots.empty() && random() % 3 != 0);
+		if (allocate)
+		{
+			size_t slot = freeSlots.back();
+			freeSlots.pop_back();
+			usedSlots.emplace_back(slot);
+			operations.emplace_back(Operation{
+				.kind = Operation::Kind::Allocate,
+				.slot = slot,
+				.size = sizeDistribution(random),
+				.alignment = size_t{1} << alignmentDistribution(random)});
+		}
+		else
+		{
+			size_t index = random() % usedSlots.size();
+			size_t slot  = usedSlots[index];
+			std::swap(usedSlots[index], usedSlots.back());
+			usedSlots.pop_back();
+			freeSlots.emplace_back(slot);
+			operations.emplace_back(Operation{.kind = Operation::Kind::Free, .slot = slot});
+		}
+	}
+
+	return operations;
+}
+
+
+// Replays the given workload using the given allocation function, and reports how long it took.
+template <typename F>
+void ReplayChurn(std::string_view name, F&& allocate, const std::vector<Operation>& operations, size_t liveCount)
+{
+	std::vector<MemoryBlock> live(liveCount);
+	size_t failures = 0;
+
+	auto start = std::chrono::steady_clock::now();
+	for (const Operation& operation : operations)
+	{
+		switch (operation.kind)
+		{
+			case Operation::Kind::Allocate:
+			{
+				AllocationResult result = allocate(AllocationRequest(operation.size, operation.alignment));
+				if (result) live[operation.slot] = result.Unwrap();
+				else failures++;
+				break;
+			}
+			case Operation::Kind::Free:
+				live[operation.slot] = MemoryBlock();
+				break;
+		}
+	}
+	live.clear();
+	auto end = std::chrono::steady_clock::now();
+
+	auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+	std::cout << name << ": "
+		<< operations.size() << " operations with " << liveCount << " live, "
+		<< static_cast<double>(nanoseconds) / operations.size() << " ns/op, "
+		<< failures << " failed allocations" << std::endl;
+}
+
+
+// Replays the given workload against a single pool allocator of type T.
+template <std::derived_from<PoolAllocator> T>
+void RunChurn(std::string_view name, Device& device, MemoryTypeIndex memoryType, const std::vector<Operation>& operations, size_t liveCount)
+{
+	T allocator(MemoryPool::Allocate(device, memoryType, POOL_SIZE).Unwrap());
+	ReplayChurn(name, [&](const AllocationRequest& request) { return allocator.Allocate(request); }, operations, liveCount);
+}
+
+
+void BenchmarkPoolAllocators(Device& device, MemoryTypeIndex memoryType)
+{
+	for (size_t liveCount : {256, 2048, 8192})
+	{
+		auto operations = GenerateChurn(200'000, liveCount);
+		RunChurn<FreeListAllocator>("FreeListAllocator", device, memoryType, operations, liveCount);
+		RunChurn<TLSFAllocator>("TLSFAllocator", device, memoryType, operations, liveCount);
+		RunChurn<BuddyAllocator>("BuddyAllocator", device, memoryType, operations, liveCount);
+	}
+}
+
+
+// Replays the workload through the device's allocator, which exercises the whole chain of allocators that
+// resource creation goes through, including dispatching frees back to the pool that made each block.
+void BenchmarkDeviceAllocator(Device& device)
+{
+	for (size_t liveCount : {256, 2048, 8192})
+	{
+		auto operations = GenerateChurn(200'000, liveCount);
+		ReplayChurn("Device Allocator", [&](const AllocationRequest& request)
+		{
+			return device.GetAllocator().Allocate(request, MemoryTypeCriteria::DeviceLocal());
+		}, operations, liveCount);
+	}
+}
+
+
+// Replays a separate workload on each of the given number of threads, all allocating through the same allocation
+// function at once. Reports the combined throughput, and checks that no two blocks which were live at the same time
+// overlapped.
+template <typename F>
+void ReplayConcurrentChurn(std::string_view name, F&& allocate, size_t threadCount, size_t operationCount, size_t liveCount)
+{
+	std::vector<std::vector<Operation>> operations;
+	for (size_t i = 0; i < threadCount; i++)
+	{
+		operations.emplace_back(GenerateChurn(operationCount, liveCount, 0x5EED + i));
+	}
+
+	std::vector<std::vector<MemoryBlock>> live(threadCount);
+	std::vector<size_t>                   failures(threadCount);
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < threadCount; i++)
+	{
+		threads.emplace_back([&, i]()
+		{
+			live[i].resize(liveCount);
+			for (const Operation& operation : operations[i])
+			{
+				switch (operation.kind)
+				{
+					case Operation::Kind::Allocate:
+					{
+						AllocationResult result = allocate(AllocationRequest(operation.size, operation.alignment));
+						if (result) live[i][operation.slot] = result.Unwrap();
+						else failures[i]++;
+						break;
+					}
+					case Operation::Kind::Free:
+						live[i][operation.slot] = MemoryBlock();
+						break;
+				}
+			}
+		});
+	}
+	for (auto& thread : threads) thread.join();
+	auto end = std::chrono::steady_clock::now();
+
+
+	std::vector<std::tuple<VkDeviceMemory, size_t, size_t>> ranges;
+	for (const auto& blocks : live)
+	{
+		for (const MemoryBlock& block : blocks)
+		{
+			if (block) ranges.emplace_back(block.Memory(), block.Offset(), block.Size());
+		}
+	}
+	std::ranges::sort(ranges);
+	size_t overlaps = 0;
+	for (size_t i = 1; i < ranges.size(); i++)
+	{
+		const auto& [previousMemory, previousOffset, previousSize] = ranges[i - 1];
+		const auto& [memory, offset, size]                         = ranges[i];
+		if (memory == previousMemory && previousOffset + previousSize > offset) overlaps++;
+	}
+	live.clear();
+
+
+	size_t totalFailures = 0;
+	for (size_t count : failures) totalFailures += count;
+	auto seconds = std::chrono::duration<double>(end - start).count();
+	std::cout << name << ": "
+		<< threadCount << " threads, "
+		<< static_cast<double>(threadCount * operationCount) / seconds << " ops/s, "
+		<< totalFailures << " failed allocations, "
+		<< overlaps << " overlapping blocks" << std::endl;
+	Core::AssertEQ(overlaps, 0);
+}
+
+
+// Serialises every call into a single threaded PolyAllocator behind one lock, which is what callers had to do before
+// ConcurrentPolyAllocator. Blocks are handed out through this adapter, so that freeing them takes the lock as well.
+template <std::derived_from<PolyAllocator> T>
+class LockedPolyAllocator
+		: public PolyAllocator
+{
+public:
+	explicit LockedPolyAllocator(Device& device)
+		: PolyAllocator(device)
+		, mAllocator(device) {}
+
+
+	AllocationResult Allocate(const AllocationRequest& allocationRequest, const MemoryTypeCriteria& memoryTypeCriteria) noexcept override
+	{
+		std::scoped_lock lock(mMutex);
+		AllocationResult result = mAllocator.Allocate(allocationRequest, memoryTypeCriteria);
+		if (!result)
+		{
+			return result;
+		}
+
+		MemoryBlock block = result.Unwrap();
+		block.Reassign(*this);
+		return block;
+	}
+
+	void Free(MemoryBlock&& address) noexcept override
+	{
+		std::scoped_lock lock(mMutex);
+		address.GetOwner()->Free(std::move(address));
+	}
+
+	bool IsThreadSafe() const noexcept override { return true; }
+
+
+	void NextFrame() noexcept override { std::scoped_lock lock(mMutex); mAllocator.NextFrame(); }
+	void Trim() noexcept override { std::scoped_lock lock(mMutex); mAllocator.Trim(); }
+	void VisitPools(const PoolVisitor& visitor) const override { std::scoped_lock lock(mMutex); mAllocator.VisitPools(visitor); }
+
+
+private:
+	mutable std::mutex mMutex;
+	T                  mAllocator;
+};
+
+
+// Compares the throughput of the concurrent front end with the single threaded one behind a global lock, which is
+// what callers had to do before, as more threads allocate at once.
+void BenchmarkConcurrentAllocators(Device& device)
+{
+	constexpr size_t OPERATION_COUNT = 100'000;
+	constexpr size_t LIVE_COUNT      = 2048;
+
+	for (size_t threadCount : {1, 2, 4, 8})
+	{
+		{
+			LockedPolyAllocator<NaivePolyAllocator<FallbackChainAllocator<TLSFAllocator>>> allocator(device);
+			ReplayConcurrentChurn("Locked NaivePolyAllocator", [&](const AllocationRequest& request)
+			{
+				return allocator.Allocate(request, MemoryTypeCriteria::DeviceLocal());
+			}, threadCount, OPERATION_COUNT, LIVE_COUNT);
+		}
+
+		{
+			ConcurrentPolyAllocator<FallbackChainAllocator<TLSFAllocator>> allocator(device);
+			ReplayConcurrentChurn("ConcurrentPolyAllocator", [&](const AllocationRequest& request)
+			{
+				return allocator.Allocate(request, MemoryTypeCriteria::DeviceLocal());
+			}, threadCount, OPERATION_COUNT, LIVE_COUNT);
+		}
+	}
+}
+
+
+// Generates the sizes of resources loaded for a synthetic scene of up to the given number of bytes: mostly textures
+// and meshes of up to a few megabytes, with an occasional large render target or streaming buffer.
+std::vector<size_t> GenerateSceneSizes(size_t totalSize)
+{
+	std::mt19937                          random(0x5CE7E);
+	std::uniform_int_distribution<size_t> smallDistribution(64 * 1024, 4 * 1024 * 1024);
+	std::uniform_int_distribution<size_t> largeDistribution(8 * 1024 * 1024, 64 * 1024 * 1024);
+
+	std::vector<size_t> sizes;
+	while (true)
+	{
+		const size_t size = random() % 16 == 0 ? largeDistribution(random) : smallDistribution(random);
+		if (size > totalSize) break;
+		sizes.emplace_back(size);
+		totalSize -= size;
+	}
+	return sizes;
+}
+
+
+// Loads the synthetic scene through a chain of pools using the given growth policy, and reports how many device
+// memory allocations were needed to hold it.
+void RunSceneLoad(std::string_view name, Device& device, MemoryTypeIndex memoryType, const ChainGrowthPolicy& growthPolicy, const std::vector<size_t>& sizes)
+{
+	FallbackChainAllocator<TLSFAllocator> allocator({device, memoryType, growthPolicy});
+
+	std::vector<MemoryBlock> live;
+	live.reserve(sizes.size());
+	size_t totalSize = 0;
+	size_t failures  = 0;
+	for (size_t size : sizes)
+	{
+		AllocationResult result = allocator.Allocate(AllocationRequest(size, 256));
+		if (!result)
+		{
+			failures++;
+			continue;
+		}
+
+		live.emplace_back(result.Unwrap());
+		totalSize += size;
+	}
+
+	const MemoryUsage usage = allocator.GetUsage();
+	std::cout << name << ": "
+		<< live.size() << " resources totalling " << totalSize / (1024 * 1024) << " MiB in "
+		<< usage.deviceAllocationCount << " device memory allocations of "
+		<< usage.reservedBytes / (1024 * 1024) << " MiB, "
+		<< usage.Fragmentation() << " fragmentation, "
+		<< failures << " failed allocations" << std::endl;
+}
+
+
+void BenchmarkGrowthPolicies(Device& device, MemoryTypeIndex memoryType)
+{
+	const auto&    memoryProperties = device.GetPhysicalDevice().GetMemoryProperties();
+	const uint32_t heapIndex        = memoryProperties.memoryTypes[memoryType.memoryTypeIndex].heapIndex;
+	const size_t   heapSize         = memoryProperties.memoryHeaps[heapIndex].size;
+
+	// Fill half of what is left of the heap's budget, so that the scene fits alongside whatever else is using the GPU.
+	const MemoryHeapBudget budget = device.GetPhysicalDevice().GetMemoryBudget()[heapIndex];
+	auto sizes = GenerateSceneSizes(budget.budget > budget.usage ? (budget.budget - budget.usage) / 2 : 0);
+	RunSceneLoad("Fixed 4 MiB pools", device, memoryType, ChainGrowthPolicy::Fixed(4 * 1024 * 1024), sizes);
+	RunSceneLoad("Geometric 4 to 64 MiB pools", device, memoryType, ChainGrowthPolicy::Geometric(4 * 1024 * 1024, 64 * 1024 * 1024), sizes);
+	RunSceneLoad("Heap sized pools", device, memoryType, ChainGrowthPolicy::ForHeap(heapSize), sizes);
+}
+
+
+// Fragments the device allocator's pools by building buffers through the device and destroying most of them, then
+// defragments what is left a step at a time, reporting how the fragmentation and number of pools change.
+void BenchmarkDefragmentation(Device& device, Queue& queue)
+{
+	constexpr size_t BUFFER_COUNT   = 1024;
+	constexpr size_t BYTES_PER_STEP = 16 * 1024 * 1024;
+
+	std::mt19937                          random(0xDEF4A6);
+	std::uniform_int_distribution<size_t> sizeDistribution(64 * 1024, 512 * 1024);
+
+	std::vector<Buffer> buffers;
+	for (size_t i = 0; i < BUFFER_COUNT; i++)
+	{
+		buffers.emplace_back(Buffer::Builder(device, MemoryTypeCriteria::DeviceLocal())
+			.WithSize(sizeDistribution(random))
+			.WithUsage(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+			.Build());
+	}
+	// Keep one buffer in four, scattered across every pool.
+	std::erase_if(buffers, [&](const Buffer&) { return random() % 4 != 0; });
+	std::vector<Buffer*> survivors;
+	for (Buffer& buffer : buffers) survivors.emplace_back(&buffer);
+
+	// Destroyed buffers are only released once the device has collected them, which happens on submission.
+	CommandPool commandPool(queue, true);
+	{
+		CommandBuffer commandBuffer(commandPool);
+		commandBuffer.Begin(true);
+		commandBuffer.End();
+		queue.Submit(commandBuffer);
+		commandBuffer.Wait();
+	}
+	device.GetDeferredReleases().Collect();
+
+	Defragmenter defragmenter(device, BYTES_PER_STEP);
+	std::cout << "Defragmentation: " << survivors.size() << " buffers in "
+		<< device.GetAllocator().GetStatistics().total.deviceAllocationCount << " device memory allocations, "
+		<< defragmenter.Fragmentation() << " fragmentation" << std::endl;
+
+	auto start = std::chrono::steady_clock::now();
+	for (unsigned step = 0; ; step++)
+	{
+		CommandBuffer commandBuffer(commandPool);
+		commandBuffer.Begin(true);
+		const Defragmenter::StepResult result = defragmenter.Step(commandBuffer, survivors);
+		commandBuffer.End();
+		queue.Submit(commandBuffer);
+		defragmenter.Retire(commandBuffer);
+		commandBuffer.Wait();
+
+		const double fragmentationAfter = defragmenter.Collect();
+		if (result.movedBuffers.empty())
+		{
+			break;
+		}
+
+		std::cout << "Step " << step << ": moved " << result.movedBuffers.size() << " buffers, "
+			<< result.movedBytes / 1024 << " KiB, fragmentation "
+			<< result.fragmentationBefore << " -> " << fragmentationAfter << std::endl;
+	}
+	auto end = std::chrono::steady_clock::now();
+
+	// Pools which were emptied are released by trimming.
+	device.GetAllocator().Trim();
+	std::cout << "Defragmented in " << std::chrono::duration<double, std::milli>(end - start).count() << " ms, leaving "
+		<< device.GetAllocator().GetStatistics().total.deviceAllocationCount << " device memory allocations, "
+		<< defragmenter.Fragmentation() << " fragmentation" << std::endl;
+}
+
+
+int main()
+{
+	glfwInit();
+
+	Instance instance;
+	const PhysicalDevice& gpu = instance.GetPhysicalDevices()[0];
+	Device device = Device::Builder(gpu)
+		.WithQueue(QueueCriteria::Transfer())
+		.Build();
+
+	MemoryTypeIndex memoryType = gpu.SearchMemoryTypes(MemoryTypeCriteria::DeviceLocal())[0].index;
+
+	BenchmarkPoolAllocators(device, memoryType);
+	BenchmarkDeviceAllocator(device);
+	BenchmarkConcurrentAllocators(device);
+	BenchmarkGrowthPolicies(device, memoryType);
+	BenchmarkDefragmentation(device, device.GetQueue(QueueCriteria::Transfer()));
+	return 0;
+}
@@ -0,0 +1,263 @@
+#include "Strawberry/Vulkan/Memory/AllocationTrace.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/BuddyAllocator.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/ChainAllocator.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/FreelistAllocator.hpp"
+#include "Strawberry/Vulkan/Memory/Allocator/TLSFAllocator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+
+// Replays allocation traces recorded with Device::Builder::WithAllocationTrace() against each of the general purpose
+// allocators. Allocators are given stand-in pools with no device memory behind them, so no GPU is needed, whatever
+// the size of the trace.
+//
+// Usage: StrawberryVulkanAllocatorReplay <trace> [allocator]
+// where allocator is one of tlsf, freelist or buddy. Every allocator is replayed if none is given.
+
+
+using namespace Strawberry;
+using namespace Vulkan;
+
+
+// Grows a chain of pool allocators over stand-in pools the way ChainAllocator grows over device memory. Pools are
+// sized as for a large heap, as traces do not record the heaps they were made on.
+template <std::derived_from<PoolAllocator> T>
+class StandInChain
+	: public MonoAllocator
+{
+public:
+	explicit StandInChain(MemoryTypeIndex memoryType)
+		: MonoAllocator(nullptr, memoryType)
+		, mGrowthPolicy(ChainGrowthPolicy::ForHeap(std::numeric_limits<size_t>::max()))
+		, mNextPoolSize(mGrowthPolicy.initialPoolSize)
+	{}
+
+
+	AllocationResult Allocate(const AllocationRequest& allocationRequest) noexcept override
+	{
+		if (allocationRequest.size > mGrowthPolicy.maxPoolSize)
+		{
+			return AllocationError::InsufficientPoolSize{};
+		}
+
+		for (auto& pool : mPools)
+		{
+			auto result = pool->Allocate(allocationRequest);
+			if (result || !result.Err().template IsType<AllocationError::OutOfMemory>())
+			{
+				return result;
+			}
+		}
+
+		const size_t required = std::min(allocationRequest.size + allocationRequest.alignment - 1, mGrowthPolicy.maxPoolSize);
+		const size_t poolSize = std::clamp(std::bit_ceil(required), mNextPoolSize, mGrowthPolicy.maxPoolSize);
+		mNextPoolSize = std::min(mNextPoolSize * mGrowthPolicy.growthFactor, mGrowthPolicy.maxPoolSize);
+		return mPools.emplace_back(std::make_unique<T>(MemoryPool(GetMemoryTypeIndex(), poolSize)))->Allocate(allocationRequest);
+	}
+
+
+	void Free(MemoryBlock&&) noexcept override
+	{
+		// Blocks are returned straight to the pool allocators which made them.
+		Core::Unreachable();
+	}
+
+
+	void VisitPools(const PoolVisitor& visitor) const override
+	{
+		for (const auto& pool : mPools) pool->VisitPools(visitor);
+	}
+
+
+private:
+	ChainGrowthPolicy               mGrowthPolicy;
+	size_t                          mNextPoolSize;
+	std::vector<std::unique_ptr<T>> mPools;
+};
+
+
+// Gives every allocation a stand-in pool of its own, as NaiveAllocator does with device memory.
+class StandInDedicated
+	: public MonoAllocator
+{
+public:
+	explicit StandInDedicated(MemoryTypeIndex memoryType)
+		: MonoAllocator(nullptr, memoryType)
+	{}
+
+
+	AllocationResult Allocate(const AllocationRequest& allocationRequest) noexcept override
+	{
+		auto& pool = mPools.emplace_back(std::make_unique<MemoryPool>(GetMemoryTypeIndex(), allocationRequest.size));
+		return pool->AllocateView(*this, 0, pool->Size());
+	}
+
+
+	void Free(MemoryBlock&& block) noexcept override
+	{
+		std::erase_if(mPools, [&](const auto& pool) { return pool.get() == block.GetMemoryPool().Get(); });
+	}
+
+
+	void VisitPools(const PoolVisitor& visitor) const override
+	{
+		for (const auto& pool : mPools) visitor(*pool, nullptr);
+	}
+
+
+private:
+	std::vector<std::unique_ptr<MemoryPool>> mPools;
+};
+
+
+// Creates the allocator under test for a single memory type.
+using AllocatorFactory = std::function<std::unique_ptr<MonoAllocator>(MemoryTypeIndex)>;
+
+
+template <std::derived_from<PoolAllocator> T>
+AllocatorFactory ChainFactory()
+{
+	return [](MemoryTypeIndex memoryType) -> std::unique_ptr<MonoAllocator>
+	{
+		return std::make_unique<StandInChain<T>>(memoryType);
+	};
+}
+
+
+// Replays the trace through allocators made by the given factory, one per memory type used in the trace. Only the
+// time spent inside the allocators is measured. Allocations which failed when recorded are skipped, and those that
+// were dedicated are given memory of their own, as they would have been.
+void Replay(std::string_view name, const AllocatorFactory& factory, const std::vector<AllocationTraceRecord>& trace)
+{
+	std::map<unsigned, std::unique_ptr<MonoAllocator>> allocators;
+	std::map<unsigned, std::unique_ptr<MonoAllocator>> dedicatedAllocators;
+	std::unordered_map<uint64_t, MemoryBlock> live;
+
+	auto reservedBytes = [&]()
+	{
+		size_t reserved = 0;
+		auto   visitor  = [&](const MemoryPool& pool, const PoolAllocator*) { reserved += pool.Size(); };
+		for (const auto& [type, allocator] : allocators) allocator->VisitPools(visitor);
+		for (const auto& [type, allocator] : dedicatedAllocators) allocator->VisitPools(visitor);
+		return reserved;
+	};
+
+	size_t operations = 0;
+	size_t failures = 0;
+	size_t usedBytes = 0;
+	size_t peakUsedBytes = 0;
+	size_t peakReservedBytes = 0;
+	double worstFragmentation = 0.0;
+	std::chrono::nanoseconds elapsed{0};
+
+	for (const AllocationTraceRecord& record : trace)
+	{
+		if (record.event == AllocationTraceEvent::Free)
+		{
+			auto block = live.find(record.id);
+			if (block == live.end()) continue;
+
+			usedBytes -= block->second.Size();
+			auto start = std::chrono::steady_clock::now();
+			live.erase(block);
+			elapsed += std::chrono::steady_clock::now() - start;
+			operations++;
+			continue;
+		}
+
+		if (!record.succeeded) continue;
+
+		// Stand-in pools only need the index of their memory type.
+		const MemoryTypeIndex memoryType{.physicalDevice = VK_NULL_HANDLE, .memoryTypeIndex = record.memoryTypeIndex};
+		auto& allocator          = allocators[record.memoryTypeIndex];
+		auto& dedicatedAllocator = dedicatedAllocators[record.memoryTypeIndex];
+		if (!allocator) allocator = factory(memoryType);
+		if (!dedicatedAllocator) dedicatedAllocator = std::make_unique<StandInDedicated>(memoryType);
+
+		// As with FallbackChainAllocator, requests too large for the chain are given memory of their own too.
+		const AllocationRequest request = AllocationRequest(record.size, record.alignment)
+			.WithResourceKind(static_cast<ResourceKind>(record.resourceKind));
+		auto start = std::chrono::steady_clock::now();
+		AllocationResult result = record.dedicated ? dedicatedAllocator->Allocate(request) : allocator->Allocate(request);
+		if (!result && result.Err().IsType<AllocationError::InsufficientPoolSize>())
+		{
+			result = dedicatedAllocator->Allocate(request);
+		}
+		elapsed += std::chrono::steady_clock::now() - start;
+		operations++;
+
+		if (!result)
+		{
+			failures++;
+			continue;
+		}
+
+		usedBytes     += record.size;
+		peakUsedBytes  = std::max(peakUsedBytes, usedBytes);
+		live.emplace(record.id, result.Unwrap());
+
+		const size_t reserved = reservedBytes();
+		if (reserved > peakReservedBytes)
+		{
+			peakReservedBytes = reserved;
+			MemoryUsage usage;
+			for (const auto& [type, typeAllocator] : allocators) usage += typeAllocator->GetUsage();
+			worstFragmentation = std::max(worstFragmentation, usage.Fragmentation());
+		}
+	}
+
+	MemoryUsage finalUsage;
+	for (const auto& [type, allocator] : allocators) finalUsage += allocator->GetUsage();
+
+	std::cout << name << ": "
+		<< operations << " operations, "
+		<< static_cast<double>(operations) / std::chrono::duration<double>(elapsed).count() << " ops/s, "
+		<< failures << " failed allocations, "
+		<< "peak footprint " << peakReservedBytes / (1024 * 1024) << " MiB for "
+		<< peakUsedBytes / (1024 * 1024) << " MiB of live blocks, "
+		<< "fragmentation " << worstFragmentation << " at peak and "
+		<< finalUsage.Fragmentation() << " at the end of the trace" << std::endl;
+}
+
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " <trace> [tlsf|freelist|buddy]" << std::endl;
+		return 1;
+	}
+
+	std::ifstream file(argv[1], std::ios::binary);
+	auto trace = ReadAllocationTrace(file);
+	if (!trace)
+	{
+		std::cerr << argv[1] << " is not an allocation trace" << std::endl;
+		return 1;
+	}
+
+	const std::string_view only = argc > 2 ? argv[2] : "";
+	const std::pair<std::string_view, AllocatorFactory> allocators[] = {
+		{"tlsf", ChainFactory<TLSFAllocator>()},
+		{"freelist", ChainFactory<FreeListAllocator>()},
+		{"buddy", ChainFactory<BuddyAllocator>()},
+	};
+	for (const auto& [name, factory] : allocators)
+	{
+		if (only.empty() || only == name)
+		{
+			Replay(name, factory, trace.Value());
+		}
+	}
+
+	return 0;
+}
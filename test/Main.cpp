@@ -18,6 +18,7 @@
 #include "Strawberry/Vulkan/Device/Surface.hpp"
 #include "Strawberry/Vulkan/Device/Swapchain.hpp"
 #include "Strawberry/Vulkan/Memory/Allocator/FreelistAllocator.hpp"
+#include "Strawberry/Vulkan/Queue/UploadManager.hpp"
 #include "Strawberry/Window/Window.hpp"
 #include "Strawberry/Vulkan/Descriptor/DescriptorPool.hpp"
 #include <iostream>
@@ -131,36 +132,15 @@ void BasicRendering()
 
 
 	auto [size, channels, bytes] = Core::IO::DynamicByteBuffer::FromImage("data/dio.png").Unwrap();
-	Buffer textureBuffer = Buffer::Builder(device, MemoryTypeCriteria::HostVisible())
-		.WithData(bytes)
-		.WithUsage(VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT)
-		.Build();
 	Image texture = Image::Builder(device, MemoryTypeCriteria::DeviceLocal())
 					.WithExtent(size).WithFormat(VK_FORMAT_R8G8B8A8_SRGB)
 					.WithUsage(
 						VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_SAMPLED_BIT).
 					Build();
 
-	commandBuffer.Begin(true);
-	commandBuffer.PipelineBarrier(VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
-								  VK_PIPELINE_STAGE_TRANSFER_BIT,
-								  0,
-								  {
-									  ImageMemoryBarrier(texture, VK_IMAGE_ASPECT_COLOR_BIT).ToLayout(
-										  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
-								  });
-	commandBuffer.CopyBufferToImage(textureBuffer, texture);
-	commandBuffer.PipelineBarrier(VK_PIPELINE_STAGE_TRANSFER_BIT,
-								  VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
-								  0,
-								  {
-									  ImageMemoryBarrier(texture, VK_IMAGE_ASPECT_COLOR_BIT).FromLayout(
-										  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL).ToLayout(
-										  VK_IMAGE_LAYOUT_GENERAL)
-								  });
-	commandBuffer.End();
-	queue->Submit(commandBuffer);
-	queue->WaitUntilIdle();
+	UploadManager& uploads = device.GetUploadManager();
+	uploads.Upload(texture, bytes, VK_IMAGE_LAYOUT_GENERAL);
+	uploads.Wait(uploads.Flush());
 	ImageView textureView = ImageView::Builder(texture, VK_IMAGE_ASPECT_COLOR_BIT)
 								   .WithType(VK_IMAGE_VIEW_TYPE_2D)
 								   .WithFormat(VK_FORMAT_R8G8B8A8_SRGB)
@@ -198,8 +178,10 @@ void BasicRendering()
 		computeCommandBuffer.BindDescriptorSet(computePipeline, 0, computeDescriptorSet);
 		computeCommandBuffer.Dispatch(256 * 256);
 		computeCommandBuffer.End();
-		computeQueue->Submit(std::move(computeCommandBuffer));
-		computeQueue->WaitUntilIdle();
+		computeQueue->Submit(computeCommandBuffer);
+		// Only the dispatch needs to finish before its results are read back, not everything on the queue.
+		computeCommandBuffer.Wait();
+		computeBuffer.Invalidate();
 
 		auto computeData = computeBuffer.GetData();
 		uint32_t* computeDataAsInts = reinterpret_cast<::uint32_t*>(computeData);
@@ -280,6 +262,8 @@ void BasicRendering()
 		commandBuffer.End();
 		commandBuffer.Submit();
 		swapchain.Present();
+
+		device.GetAllocator().NextFrame();
 	}
 }
 